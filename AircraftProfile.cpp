@@ -0,0 +1,152 @@
+#include "AircraftProfile.h"
+#include "Console.h"
+#include "PiecewiseLinear.h"
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cctype>
+
+// compute tables from aircraft parameters when no profile file exists
+void AircraftProfile::computeDefault(const AircraftParameters& aircraftParameters)
+{
+    parameters = aircraftParameters;
+    float cruiseSpeed = parameters.estimatedCruiseSpeed > 0 ? static_cast<float>(parameters.estimatedCruiseSpeed) : 100.0f;
+
+    // force gain rises linearly up to cruise speed and saturates at 1.5 of cruise speed
+    maxAirspeed = 2 * cruiseSpeed;
+    fillTable(forceGainTable, { 0.0f, 0.0f, cruiseSpeed, 1.0f, 1.5f * cruiseSpeed, 1.5f, maxAirspeed, 1.5f }, 0, maxAirspeed);
+
+    // linear yoke response
+    yokeXCurve = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+    // evenly distributed flaps detents
+    size_t numberOfPositions = static_cast<size_t>(parameters.flapsNumHandlePositions);
+    for (size_t index = 0; index <= MaxFlapsPositions; index++)
+    {
+        flapsDetents[index] = numberOfPositions ? static_cast<float>(index < numberOfPositions ? index : numberOfPositions) / numberOfPositions : 0.0f;
+    }
+}
+
+// load tables from the profile file
+// every line contains a table name and a list of values; lines starting with # are ignored
+//   force_gain <airspeed> <gain> ...        breakpoints of force gain vs airspeed [kts]
+//   yoke_x_curve <position> <response> ...   breakpoints of yoke X response in range -1..1; a yoke_x line of the axis curve file overrides it
+//   flaps_detents <position> ...            lever positions 0..1 of flaps handle indexes 0..n
+bool AircraftProfile::loadFromFile(std::string fileName)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream lineStream(line);
+        std::string name;
+        lineStream >> name;
+        if (name.empty() || (name[0] == '#'))
+        {
+            continue;
+        }
+        std::vector<float> values;
+        float value;
+        while (lineStream >> value)
+        {
+            values.push_back(value);
+        }
+
+        if ((name == "force_gain") && (values.size() >= 4) && (values[values.size() / 2 * 2 - 2] > 0))
+        {
+            maxAirspeed = values[values.size() / 2 * 2 - 2];     // the last breakpoint airspeed
+            fillTable(forceGainTable, values, 0, maxAirspeed);
+        }
+        else if ((name == "yoke_x_curve") && (values.size() >= 4))
+        {
+            yokeXCurve.assign(values.begin(), values.begin() + values.size() / 2 * 2);
+        }
+        else if ((name == "flaps_detents") && !values.empty())
+        {
+            for (size_t index = 0; index <= MaxFlapsPositions; index++)
+            {
+                flapsDetents[index] = values[index < values.size() ? index : values.size() - 1];
+            }
+        }
+        else
+        {
+            Console::getInstance().log(LogLevel::Warning, "invalid profile entry: " + line);
+        }
+    }
+    return true;
+}
+
+float AircraftProfile::getForceGain(double indicatedAirspeed) const
+{
+    return lookup(forceGainTable, static_cast<float>(indicatedAirspeed), 0, maxAirspeed);
+}
+
+float AircraftProfile::getFlapsLeverPosition(double flapsHandleIndex) const
+{
+    size_t index = flapsHandleIndex > 0 ? static_cast<size_t>(flapsHandleIndex) : 0;
+    return flapsDetents[index < MaxFlapsPositions ? index : MaxFlapsPositions];
+}
+
+// fill the dense table with piecewise linear function given by breakpoints x0 y0 x1 y1 ... (x ascending)
+template<size_t N>
+void AircraftProfile::fillTable(std::array<float, N>& table, const std::vector<float>& breakpoints, float xMin, float xMax)
+{
+    for (size_t index = 0; index < N; index++)
+    {
+        table[index] = piecewiseLinear(breakpoints, xMin + (xMax - xMin) * index / (N - 1));
+    }
+}
+
+// linear interpolation in the dense table; x is clamped to xMin..xMax
+template<size_t N>
+float AircraftProfile::lookup(const std::array<float, N>& table, float x, float xMin, float xMax)
+{
+    float position = (x - xMin) * (N - 1) / (xMax - xMin);
+    position = position < 0 ? 0 : (position > N - 1 ? N - 1 : position);
+    size_t index = static_cast<size_t>(position);
+    if (index >= N - 1)
+    {
+        return table[N - 1];
+    }
+    float fraction = position - index;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+// get profile of the aircraft; load it from disk when used for the first time
+const AircraftProfile* ProfileCache::getProfile(std::string title, const AircraftParameters& parameters)
+{
+    auto it = profiles.find(title);
+    if (it != profiles.end())
+    {
+        return &it->second;
+    }
+
+    auto loadStartTime = std::chrono::steady_clock::now();
+    AircraftProfile& profile = profiles[title];
+    profile.computeDefault(parameters);
+    std::string fileName = ProfileDirectory + getFileName(title);
+    bool isLoaded = profile.loadFromFile(fileName);
+    std::stringstream ss;
+    ss << "aircraft profile for '" << title.c_str() << "' " << (isLoaded ? "loaded from " + fileName : std::string("computed from defaults"));
+    ss << " in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStartTime).count() << " ms";
+    Console::getInstance().log(LogLevel::Info, ss.str());
+    return &profile;
+}
+
+// convert aircraft title to file name
+std::string ProfileCache::getFileName(std::string title)
+{
+    for (auto& character : title)
+    {
+        if (!isalnum(static_cast<unsigned char>(character)) && (character != '-'))
+        {
+            character = '_';
+        }
+    }
+    return title + ".txt";
+}
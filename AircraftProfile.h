@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+
+struct AircraftParameters   // aircraft parameters read from simulator on aircraft change
+{
+    double numberOfEngines;
+    double flapsNumHandlePositions;     // number of flaps positions excluding position 0
+    double estimatedCruiseSpeed;        // [kts]
+};
+
+// per-aircraft calibration tables precomputed for table lookup on the hot path
+class AircraftProfile
+{
+public:
+    static const size_t TableSize = 65;     // number of points of every dense table
+    static const size_t MaxFlapsPositions = 16;
+    void computeDefault(const AircraftParameters& parameters);      // tables derived from aircraft parameters only
+    bool loadFromFile(std::string fileName);    // overrides default tables with the profile file content
+    float getForceGain(double indicatedAirspeed) const;     // force feedback gain vs airspeed [kts]
+    const std::vector<float>& getYokeXCurve(void) const { return yokeXCurve; }     // breakpoints of the yoke X response -1..1 -> -1..1; the default of the yoke X axis curve
+    float getFlapsLeverPosition(double flapsHandleIndex) const;     // flaps detent position 0..1
+    const AircraftParameters& getParameters(void) const { return parameters; }
+private:
+    template<size_t N> static void fillTable(std::array<float, N>& table, const std::vector<float>& breakpoints, float xMin, float xMax);
+    template<size_t N> static float lookup(const std::array<float, N>& table, float x, float xMin, float xMax);
+    AircraftParameters parameters{ 0, 0, 0 };
+    float maxAirspeed{ 1 };     // upper limit of forceGainTable [kts]
+    std::array<float, TableSize> forceGainTable;        // over airspeed 0..maxAirspeed
+    std::vector<float> yokeXCurve;      // compiled into the yoke X lookup table of AxisCurves
+    std::array<float, MaxFlapsPositions + 1> flapsDetents;    // lever position of every flaps handle index
+};
+
+// cache of aircraft profiles keyed by aircraft title
+class ProfileCache
+{
+public:
+    const AircraftProfile* getProfile(std::string title, const AircraftParameters& parameters);    // loads the profile on the first use
+    size_t size(void) const { return profiles.size(); }
+private:
+    static std::string getFileName(std::string title);
+    std::unordered_map<std::string, AircraftProfile> profiles;
+    const std::string ProfileDirectory = "profiles/";     // the forward slash also works on Windows
+};
@@ -8,10 +8,10 @@ class Arbiter
 public:
     bool setRequested(T remote, T local, uint16_t counterLoad);
 private:
-    T lastRemote;
-    T lastLocal;
-    uint16_t remoteCounter;
-    uint16_t localCounter;
+    T lastRemote{};
+    T lastLocal{};
+    uint16_t remoteCounter{ 0 };
+    uint16_t localCounter{ 0 };
 };
 
 template <class T>
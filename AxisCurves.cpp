@@ -0,0 +1,219 @@
+#include "AxisCurves.h"
+#include "Console.h"
+#include "PiecewiseLinear.h"
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+AxisCurves::AxisCurves()
+{
+    std::unique_ptr<LutSet> pNewSet(new LutSet);
+    for (int axis = 0; axis < NumberOfAxes; axis++)
+    {
+        compile(static_cast<Axis>(axis), AxisCurveConfig(), *pNewSet);
+    }
+    publish(std::move(pNewSet));
+}
+
+// override the curve of one axis
+void AxisCurves::configure(Axis axis, const AxisCurveConfig& config)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    overrides[axis] = config;
+    isOverridden[axis] = true;
+    std::unique_ptr<LutSet> pNewSet(new LutSet(*pLutSet.load()));
+    compile(axis, config, *pNewSet);
+    publish(std::move(pNewSet));
+}
+
+// set the curve of the aircraft profile; it is used while the axis is not overridden
+void AxisCurves::setProfileCurve(Axis axis, const std::vector<float>& points)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    profileCurves[axis] = points;
+    if (!isOverridden[axis])
+    {
+        std::unique_ptr<LutSet> pNewSet(new LutSet(*pLutSet.load()));
+        compile(axis, getEffectiveConfig(axis), *pNewSet);
+        publish(std::move(pNewSet));
+    }
+}
+
+// the override of the curve file, or the aircraft profile curve without other shaping
+AxisCurveConfig AxisCurves::getEffectiveConfig(Axis axis) const
+{
+    if (isOverridden[axis])
+    {
+        return overrides[axis];
+    }
+    AxisCurveConfig config;
+    config.points = profileCurves[axis];
+    return config;
+}
+
+// the new set is complete before the pointer is swapped, so evaluate sees either the old or the new tables
+// a replaced set is freed by a later publish once evaluate no longer reads it, so at most two sets are kept
+void AxisCurves::publish(std::unique_ptr<LutSet> pNewSet)
+{
+    pLutSet.store(pNewSet.get());
+    if (pCurrentSet)
+    {
+        retiredSets.push_back(std::move(pCurrentSet));
+    }
+    pCurrentSet = std::move(pNewSet);
+    const LutSet* pInUse = pReadSet.load();
+    retiredSets.erase(std::remove_if(retiredSets.begin(), retiredSets.end(), [pInUse](const std::unique_ptr<LutSet>& pSet) { return pSet.get() != pInUse; }), retiredSets.end());
+}
+
+size_t AxisCurves::getNumberOfSets(void)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return retiredSets.size() + (pCurrentSet ? 1 : 0);
+}
+
+// compute the lookup table of the axis
+void AxisCurves::compile(Axis axis, const AxisCurveConfig& config, LutSet& lutSet) const
+{
+    float table[LutSize + 1];
+    float deadzone = (std::min)((std::max)(config.deadzone, 0.0f), 0.99f);
+
+    for (size_t index = 0; index <= LutSize; index++)
+    {
+        float x = static_cast<float>(index) / LutSize;
+        if (isBipolar[axis])
+        {
+            x = 2 * x - 1;
+        }
+
+        // deadzone
+        float magnitude = (std::max)(fabsf(x) - deadzone, 0.0f) / (1 - deadzone);
+        float y = x < 0 ? -magnitude : magnitude;
+
+        // expo
+        y = (1 - config.expo) * y + config.expo * y * y * y;
+
+        // breakpoints
+        y = piecewiseLinear(config.points, y);
+
+        // detents
+        for (auto detent : config.detents)
+        {
+            if (fabsf(y - detent) < config.detentWidth)
+            {
+                y = detent;
+            }
+        }
+
+        table[index] = y;
+    }
+
+    memcpy(lutSet.lut[axis], table, sizeof(table));
+    lutSet.inputScale[axis] = isBipolar[axis] ? LutSize / 2.0f : static_cast<float>(LutSize);
+    lutSet.inputOffset[axis] = isBipolar[axis] ? LutSize / 2.0f : 0.0f;
+}
+
+// load axis curves from the file
+// every line describes one axis: <axis name> [deadzone <v>] [expo <v>] [points <x> <y> ...] [detents <v> ...] [width <v>]
+bool AxisCurves::loadFromFile(std::string fileName)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    // all axes of the file are swapped at once; axes missing in the file return to the aircraft profile curve
+    std::lock_guard<std::mutex> lock(configMutex);
+    for (int axis = 0; axis < NumberOfAxes; axis++)
+    {
+        isOverridden[axis] = false;
+    }
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream lineStream(line);
+        std::string name;
+        lineStream >> name;
+        if (name.empty() || (name[0] == '#'))
+        {
+            continue;
+        }
+        auto pAxisName = std::find(std::begin(axisNames), std::end(axisNames), name);
+        if (pAxisName == std::end(axisNames))
+        {
+            Console::getInstance().log(LogLevel::Warning, "unknown axis: " + name);
+            continue;
+        }
+
+        AxisCurveConfig config;
+        std::vector<float>* pList = nullptr;       // list being read
+        std::string token;
+        while (lineStream >> token)
+        {
+            if (token == "deadzone")
+            {
+                lineStream >> config.deadzone;
+            }
+            else if (token == "expo")
+            {
+                lineStream >> config.expo;
+            }
+            else if (token == "width")
+            {
+                lineStream >> config.detentWidth;
+            }
+            else if (token == "points")
+            {
+                pList = &config.points;
+            }
+            else if (token == "detents")
+            {
+                pList = &config.detents;
+            }
+            else if (pList)
+            {
+                float value;
+                if (std::istringstream(token) >> value)
+                {
+                    pList->push_back(value);
+                }
+            }
+        }
+        size_t axis = pAxisName - std::begin(axisNames);
+        overrides[axis] = config;
+        isOverridden[axis] = true;
+        Console::getInstance().log(LogLevel::Debug, "axis curve configured: " + line);
+    }
+    std::unique_ptr<LutSet> pNewSet(new LutSet);
+    for (int axis = 0; axis < NumberOfAxes; axis++)
+    {
+        compile(static_cast<Axis>(axis), getEffectiveConfig(static_cast<Axis>(axis)), *pNewSet);
+    }
+    publish(std::move(pNewSet));
+    return true;
+}
+
+// apply curves to all axes in one pass
+// the loop has no data dependent branches: input clamping and the table index are computed with min/max
+void AxisCurves::evaluate(const float inputs[NumberOfAxes], float outputs[NumberOfAxes])
+{
+    // announce the set before reading it; a set swapped in meanwhile is taken instead, because publish may free the announced one
+    const LutSet* pSet = pLutSet.load(std::memory_order_acquire);
+    pReadSet.store(pSet);
+    for (const LutSet* pLatest = pLutSet.load(); pLatest != pSet; pLatest = pLutSet.load())
+    {
+        pSet = pLatest;
+        pReadSet.store(pSet);
+    }
+    const LutSet& lutSet = *pSet;
+    for (int axis = 0; axis < NumberOfAxes; axis++)
+    {
+        float position = (std::min)((std::max)(inputs[axis] * lutSet.inputScale[axis] + lutSet.inputOffset[axis], 0.0f), static_cast<float>(LutSize));
+        int index = (std::min)(static_cast<int>(position), static_cast<int>(LutSize) - 1);
+        float fraction = position - index;
+        outputs[axis] = lutSet.lut[axis][index] + (lutSet.lut[axis][index + 1] - lutSet.lut[axis][index]) * fraction;
+    }
+    pReadSet.store(nullptr, std::memory_order_release);
+}
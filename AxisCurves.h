@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+struct AxisCurveConfig      // response curve parameters of a single axis
+{
+    float deadzone{ 0 };    // part of the input range around zero (bipolar) or at the beginning (unipolar) with no output
+    float expo{ 0 };        // 0 = linear, 1 = cubic response
+    std::vector<float> points;      // optional breakpoints x0 y0 x1 y1 ... applied after expo
+    std::vector<float> detents;     // output values which the axis snaps to
+    float detentWidth{ 0 };         // half width of the snap range around every detent
+};
+
+// response curves of all joystick axes compiled into lookup tables - the only curve stage of the joystick inputs
+// an axis follows the curve of the aircraft profile (linear without one) unless the curve file or configure overrides it
+class AxisCurves
+{
+public:
+    enum Axis
+    {
+        YokeX,
+        Throttle1,
+        Throttle2,
+        Throttle3,
+        Throttle4,
+        NumberOfAxes
+    };
+    AxisCurves();
+    void configure(Axis axis, const AxisCurveConfig& config);      // overrides the curve and compiles it into the lookup table
+    void setProfileCurve(Axis axis, const std::vector<float>& points);     // breakpoints of the aircraft profile curve
+    bool loadFromFile(std::string fileName);    // overrides the axes listed in the curve file; the other axes follow the profile
+    void evaluate(const float inputs[NumberOfAxes], float outputs[NumberOfAxes]);     // applies curves to all axes at once; to be called from one thread only
+    size_t getNumberOfSets(void);       // lookup table sets in memory: the current one and the retired ones still being read
+private:
+    static const size_t LutSize = 256;      // number of table intervals
+    struct LutSet       // lookup tables of all axes; never changed after publishing
+    {
+        float lut[NumberOfAxes][LutSize + 1];   // output values for evenly spaced inputs
+        float inputScale[NumberOfAxes];         // maps the axis input range to 0..LutSize
+        float inputOffset[NumberOfAxes];
+    };
+    void compile(Axis axis, const AxisCurveConfig& config, LutSet& lutSet) const;
+    AxisCurveConfig getEffectiveConfig(Axis axis) const;
+    void publish(std::unique_ptr<LutSet> pNewSet);      // makes the set current for evaluate
+    std::mutex configMutex;     // serializes configuration; evaluate does not lock
+    AxisCurveConfig overrides[NumberOfAxes];    // curves from the curve file or configure
+    bool isOverridden[NumberOfAxes]{};
+    std::vector<float> profileCurves[NumberOfAxes];     // breakpoints of the aircraft profile curves
+    std::unique_ptr<LutSet> pCurrentSet;        // owner of the current set
+    std::vector<std::unique_ptr<LutSet>> retiredSets;   // replaced sets which evaluate may still be reading
+    std::atomic<const LutSet*> pLutSet{ nullptr };      // current set
+    std::atomic<const LutSet*> pReadSet{ nullptr };     // set being read by evaluate; a single reader thread is supported
+    const char* axisNames[NumberOfAxes] = { "yoke_x", "throttle_1", "throttle_2", "throttle_3", "throttle_4" };
+    const bool isBipolar[NumberOfAxes] = { true, false, false, false, false };     // input range -1..1 or 0..1
+};
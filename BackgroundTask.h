@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Console.h"
+#include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+// runs a long command in its own thread, so the caller (console, reactor, command server) is not blocked
+// a second start is refused while the task is running; it may be requested from any thread
+class BackgroundTask
+{
+public:
+    BackgroundTask(std::string name, std::function<void(void)> task) : name(name), task(task) {}
+    ~BackgroundTask();
+    BackgroundTask(BackgroundTask const&) = delete;
+    BackgroundTask& operator=(BackgroundTask const&) = delete;
+    void start(void);
+    bool isRunning(void) const { return running; }
+private:
+    std::string name;
+    std::function<void(void)> task;
+    std::atomic<bool> running{ false };
+    std::thread taskThread;
+};
+
+inline BackgroundTask::~BackgroundTask()
+{
+    if (taskThread.joinable())
+    {
+        taskThread.join();
+    }
+}
+
+inline void BackgroundTask::start(void)
+{
+    if (running.exchange(true))
+    {
+        Console::getInstance().log(LogLevel::Warning, name + " is already running");
+        return;
+    }
+    if (taskThread.joinable())
+    {
+        // the previous run has finished - the join returns immediately
+        taskThread.join();
+    }
+    taskThread = std::thread([this]()
+        {
+            task();
+            running = false;
+        });
+}
@@ -0,0 +1,212 @@
+#include "CommandServer.h"
+#include "Console.h"
+
+CommandServer::CommandServer()
+{
+    for (auto& instance : pipes)
+    {
+        memset(&instance.overlapped, 0, sizeof(instance.overlapped));
+        instance.overlapped.hEvent = CreateEvent(NULL, TRUE, TRUE, NULL);
+    }
+    // the response of a deferred command completes the waiting pipe instance
+    sessions.setResponseHandler([this](size_t client)
+        {
+            for (auto& instance : pipes)
+            {
+                if (instance.client == client)
+                {
+                    SetEvent(instance.overlapped.hEvent);
+                }
+            }
+        });
+}
+
+CommandServer::~CommandServer()
+{
+    for (auto& instance : pipes)
+    {
+        CloseHandle(instance.overlapped.hEvent);
+    }
+}
+
+// command server event loop
+// all pipe instances are serviced in this thread without blocking on any of them
+void CommandServer::handler(void)
+{
+    for (auto& instance : pipes)
+    {
+        if (!createInstance(instance))
+        {
+            return;
+        }
+        connect(instance);
+    }
+    Console::getInstance().log(LogLevel::Debug, "command server started");
+
+    HANDLE handles[MaxClients + 1];
+    handles[0] = Console::getInstance().getQuitEvent().getNativeHandle();
+    for (DWORD index = 0; index < MaxClients; index++)
+    {
+        handles[index + 1] = pipes[index].overlapped.hEvent;
+    }
+
+    // stay in this loop until the user requests quit
+    while (!Console::getInstance().isQuitRequest())
+    {
+        DWORD result = WaitForMultipleObjects(MaxClients + 1, handles, FALSE, INFINITE);
+        if (result == WAIT_OBJECT_0)
+        {
+            // quit requested
+            break;
+        }
+        DWORD index = result - WAIT_OBJECT_0 - 1;
+        if (index < MaxClients)
+        {
+            service(pipes[index]);
+        }
+        else
+        {
+            Console::getInstance().log(LogLevel::Error, "command server wait error=" + std::to_string(GetLastError()));
+            break;
+        }
+    }
+
+    for (auto& instance : pipes)
+    {
+        if (instance.hPipe != INVALID_HANDLE_VALUE)
+        {
+            CancelIo(instance.hPipe);
+            DisconnectNamedPipe(instance.hPipe);
+            CloseHandle(instance.hPipe);
+            instance.hPipe = INVALID_HANDLE_VALUE;
+        }
+    }
+}
+
+// create a new instance of the named pipe
+bool CommandServer::createInstance(PipeInstance& instance)
+{
+    instance.hPipe = CreateNamedPipe(PipeName, PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+        PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        MaxClients, 0, RequestBufferSize, 0, NULL);
+    if (instance.hPipe == INVALID_HANDLE_VALUE)
+    {
+        Console::getInstance().log(LogLevel::Error, "command server pipe creation error=" + std::to_string(GetLastError()));
+        return false;
+    }
+    return true;
+}
+
+// start waiting for a client in asynchronous mode
+void CommandServer::connect(PipeInstance& instance)
+{
+    instance.state = PipeState::Connecting;
+    if (ConnectNamedPipe(instance.hPipe, &instance.overlapped) == 0)
+    {
+        DWORD lastError = GetLastError();
+        if (lastError == ERROR_PIPE_CONNECTED)
+        {
+            // the client connected before ConnectNamedPipe was called
+            instance.client = sessions.connect();
+            if (instance.client != CommandSessions::NoClient)
+            {
+                startReading(instance);
+            }
+            else
+            {
+                reconnect(instance);
+            }
+        }
+        else if (lastError != ERROR_IO_PENDING)
+        {
+            Console::getInstance().log(LogLevel::Warning, "command server connection error=" + std::to_string(lastError));
+        }
+    }
+}
+
+// drop the current client and wait for a new one
+void CommandServer::reconnect(PipeInstance& instance)
+{
+    sessions.disconnect(instance.client);
+    instance.client = CommandSessions::NoClient;
+    DisconnectNamedPipe(instance.hPipe);
+    connect(instance);
+}
+
+// start reading a command in asynchronous mode
+void CommandServer::startReading(PipeInstance& instance)
+{
+    instance.state = PipeState::Reading;
+    if ((ReadFile(instance.hPipe, instance.requestBuffer, RequestBufferSize, NULL, &instance.overlapped) == 0) &&
+        (GetLastError() != ERROR_IO_PENDING))
+    {
+        reconnect(instance);
+    }
+}
+
+// start writing a response in asynchronous mode
+void CommandServer::startWriting(PipeInstance& instance)
+{
+    instance.state = PipeState::Writing;
+    instance.response = sessions.takeResponse(instance.client);
+    if ((WriteFile(instance.hPipe, instance.response.c_str(), static_cast<DWORD>(instance.response.size()), NULL, &instance.overlapped) == 0) &&
+        (GetLastError() != ERROR_IO_PENDING))
+    {
+        reconnect(instance);
+    }
+}
+
+// continue servicing the pipe instance after its pending operation has been completed
+void CommandServer::service(PipeInstance& instance)
+{
+    DWORD transferredCount = 0;
+    bool overlappedResult = GetOverlappedResult(instance.hPipe, &instance.overlapped, &transferredCount, FALSE);
+
+    switch (instance.state)
+    {
+    case PipeState::Connecting:
+        instance.client = overlappedResult ? sessions.connect() : CommandSessions::NoClient;
+        if (instance.client != CommandSessions::NoClient)
+        {
+            startReading(instance);
+        }
+        else
+        {
+            reconnect(instance);
+        }
+        break;
+
+    case PipeState::Reading:
+        if (overlappedResult && (transferredCount > 0))
+        {
+            // a deferred command sets the pipe event when its response is ready
+            instance.state = PipeState::Executing;
+            ResetEvent(instance.overlapped.hEvent);
+            if (sessions.request(instance.client, std::string(instance.requestBuffer, transferredCount)))
+            {
+                startWriting(instance);
+            }
+        }
+        else
+        {
+            // client disconnected or the command is too long
+            reconnect(instance);
+        }
+        break;
+
+    case PipeState::Executing:
+        startWriting(instance);
+        break;
+
+    case PipeState::Writing:
+        if (overlappedResult)
+        {
+            startReading(instance);
+        }
+        else
+        {
+            reconnect(instance);
+        }
+        break;
+    }
+}
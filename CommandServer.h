@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Platform.h"
+#include "CommandSessions.h"
+#include <Windows.h>
+#include <string>
+
+// serves console commands to local clients over a named pipe
+// the protocol of the clients (framing, remote commands, deferred execution) is kept by CommandSessions
+class CommandServer
+{
+public:
+    CommandServer();
+    ~CommandServer();
+    void handler(void);     // event loop to be called in a separate thread
+    void setDeferredExecution(bool deferred) { sessions.setDeferredExecution(deferred); }     // commands are executed by executePending instead of the pipe thread
+    Event& getRequestEvent(void) { return sessions.getRequestEvent(); }      // signaled when deferred commands wait for execution
+    void executePending(void) { sessions.executePending(); }       // executes deferred commands; to be called by the thread which owns the simulator state
+private:
+    enum class PipeState
+    {
+        Connecting,     // waiting for a client
+        Reading,        // waiting for a command
+        Executing,      // waiting for deferred execution of the command
+        Writing         // sending a response
+    };
+    static const DWORD MaxClients = static_cast<DWORD>(CommandSessions::MaxClients);
+    static const DWORD RequestBufferSize = 256;
+    struct PipeInstance
+    {
+        HANDLE hPipe{ INVALID_HANDLE_VALUE };
+        OVERLAPPED overlapped;
+        PipeState state{ PipeState::Connecting };
+        char requestBuffer[RequestBufferSize];
+        size_t client{ CommandSessions::NoClient };     // session of the connected client
+        std::string response;       // kept until the write completes
+    };
+    bool createInstance(PipeInstance& instance);
+    void connect(PipeInstance& instance);       // starts waiting for a client
+    void reconnect(PipeInstance& instance);     // drops the current client and waits for a new one
+    void startReading(PipeInstance& instance);
+    void startWriting(PipeInstance& instance);
+    void service(PipeInstance& instance);       // continues after completion of the pending operation
+    PipeInstance pipes[MaxClients];
+    CommandSessions sessions;
+    const wchar_t* PipeName = L"\\\\.\\pipe\\MsSimConnect";
+};
@@ -0,0 +1,101 @@
+#include "CommandSessions.h"
+#include "Console.h"
+#include <algorithm>
+
+size_t CommandSessions::connect(void)
+{
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    for (size_t client = 0; client < MaxClients; client++)
+    {
+        if (!sessions[client].isConnected)
+        {
+            sessions[client] = Session();
+            sessions[client].isConnected = true;
+            return client;
+        }
+    }
+    return NoClient;
+}
+
+void CommandSessions::disconnect(size_t client)
+{
+    if (client >= MaxClients)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    sessions[client].isConnected = false;
+    pendingRequests.erase(std::remove(pendingRequests.begin(), pendingRequests.end(), client), pendingRequests.end());
+}
+
+// take the command of the request message and execute it or queue it for the owner thread
+bool CommandSessions::request(size_t client, const std::string& message)
+{
+    if (client >= MaxClients)
+    {
+        return false;
+    }
+    std::string command = message.substr(0, message.find_last_not_of(" \r\n") + 1);
+    if (deferredExecution)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            sessions[client].command = command;
+            pendingRequests.push_back(client);
+        }
+        requestEvent.set();
+        return false;
+    }
+
+    std::string response = Console::getInstance().executeRemoteCommand(command) + "\n";
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    sessions[client].response = response;
+    return true;
+}
+
+std::string CommandSessions::takeResponse(size_t client)
+{
+    if (client >= MaxClients)
+    {
+        return std::string();
+    }
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    std::string response;
+    response.swap(sessions[client].response);
+    return response;
+}
+
+// execute the queued commands and hand their responses back to the transport
+void CommandSessions::executePending(void)
+{
+    while (true)
+    {
+        size_t client;
+        std::string command;
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            if (pendingRequests.empty())
+            {
+                return;
+            }
+            client = pendingRequests.front();
+            pendingRequests.pop_front();
+            command = sessions[client].command;
+        }
+        std::string response = Console::getInstance().executeRemoteCommand(command) + "\n";
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            sessions[client].response = response;
+        }
+        if (responseHandler)
+        {
+            responseHandler(client);
+        }
+    }
+}
+
+size_t CommandSessions::getNumberOfClients(void)
+{
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return std::count_if(std::begin(sessions), std::end(sessions), [](const Session& session) { return session.isConnected; });
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Platform.h"
+#include <string>
+#include <deque>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+// protocol of the remote command clients independent of their transport (the named pipe of the command server)
+// every request is a single command name; every response is a single JSON line
+// the commands are executed at once or deferred to the thread which owns the simulator state
+class CommandSessions
+{
+public:
+    static const size_t MaxClients = 4;
+    static constexpr size_t NoClient = SIZE_MAX;
+    size_t connect(void);       // returns the slot of a new client or NoClient if all slots are taken
+    void disconnect(size_t client);     // frees the slot; a deferred command of the client is dropped
+    bool request(size_t client, const std::string& message);   // true if the response is ready; false if the command waits for executePending
+    std::string takeResponse(size_t client);
+    void setDeferredExecution(bool deferred) { deferredExecution = deferred; }
+    Event& getRequestEvent(void) { return requestEvent; }      // signaled when deferred commands wait for execution
+    void setResponseHandler(std::function<void(size_t client)> handler) { responseHandler = handler; }     // called by executePending for every executed command
+    void executePending(void);      // executes deferred commands; to be called by the thread which owns the simulator state
+    size_t getNumberOfClients(void);
+private:
+    struct Session
+    {
+        bool isConnected{ false };
+        std::string command;
+        std::string response;
+    };
+    Session sessions[MaxClients];
+    bool deferredExecution{ false };
+    Event requestEvent{ false };
+    std::mutex sessionMutex;
+    std::deque<size_t> pendingRequests;     // clients with a command waiting for deferred execution
+    std::function<void(size_t client)> responseHandler;
+};
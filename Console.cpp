@@ -1,5 +1,4 @@
 #include "Console.h"
-#include <conio.h>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -13,7 +12,7 @@ Console& Console::getInstance()
 
 Console::Console()
 {
-    registerCommand("quit", "quit the program", std::bind(&Console::quit, this));
+    registerCommand("quit", "quit the program", std::bind(&Console::quit, this), true);
     registerCommand("help", "display console commands", std::bind(&Console::help, this));
 }
 
@@ -24,26 +23,38 @@ void Console::handler(void)
     {
         std::cout << "\n>" << std::flush;
 
-        std::string command;
-        std::cin >> command;
-
-        if (commands.find(command) != commands.end())
+        std::string line;
+        if (!readConsoleLine(line, quitEvent))
         {
-            // command exists - execute it
-            commands[command].second();
+            // end of console input or input cancelled by quit request
+            quit();
+            break;
         }
-        else
+        std::string command;
+        std::istringstream(line) >> command;
+        if (!command.empty())
         {
-            //command not found
-            std::cout << "\ninvalid command: " << command.c_str();
+            execute(command);
         }
-
-        std::cin.clear();
-        std::cin.ignore(INT_MAX, '\n');
     }
 }
 
 
+// execute console command
+void Console::execute(std::string command)
+{
+    if (commands.find(command) != commands.end())
+    {
+        // command exists - execute it
+        commands[command].action();
+    }
+    else
+    {
+        //command not found
+        std::cout << "\ninvalid command: " << command.c_str();
+    }
+}
+
 // log message in console window
 void Console::log(LogLevel level, std::string message)
 {
@@ -51,14 +62,78 @@ void Console::log(LogLevel level, std::string message)
     int iLevel = static_cast<int>(level);
     if ((iLevel <= iCurrentLevel) && (iCurrentLevel > 0))
     {
+        std::lock_guard<std::mutex> lock(outputMutex);
         std::cout << "\r" << levelText.find(level)->second.c_str() << ": " << message.c_str() << std::endl;
     }
 }
 
 //register console command
-void Console::registerCommand(std::string command, std::string description, std::function<void(void)> action)
+void Console::registerCommand(std::string command, std::string description, std::function<void(void)> action, bool isRemote)
+{
+    commands[command] = Command{ description, action, isRemote };
+}
+
+// request quit and wake up all waiting threads
+void Console::quit(void)
+{
+    quitRequest = true;
+    quitEvent.set();
+    // the console handler may be blocked reading the input
+    cancelConsoleInput();
+}
+
+//register JSON query of the console command for remote clients
+void Console::registerQuery(std::string command, std::function<std::string(void)> query)
+{
+    queries[command] = query;
+}
+
+// execute command received from remote client
+// a registered query returns its JSON snapshot; remote commands return the execution status
+// remote commands are executed in the command server thread, so only the non-blocking ones are allowed
+std::string Console::executeRemoteCommand(std::string command)
 {
-    commands[command] = std::pair < std::string, std::function<void(void)>>(description, action);
+    std::stringstream ss;
+    if (queries.find(command) != queries.end())
+    {
+        return queries[command]();
+    }
+    else if (command == "help")
+    {
+        ss << "{\"queries\":[";
+        for (auto it = queries.begin(); it != queries.end(); it++)
+        {
+            ss << (it == queries.begin() ? "" : ",") << "\"" << it->first.c_str() << "\"";
+        }
+        ss << "],\"commands\":{";
+        bool isFirst = true;
+        for (auto const& [name, entry] : commands)
+        {
+            if (entry.isRemote)
+            {
+                ss << (isFirst ? "" : ",") << "\"" << name.c_str() << "\":\"" << entry.description.c_str() << "\"";
+                isFirst = false;
+            }
+        }
+        ss << "}}";
+    }
+    else if (commands.find(command) != commands.end())
+    {
+        if (commands[command].isRemote)
+        {
+            commands[command].action();
+            ss << "{\"command\":\"" << command.c_str() << "\",\"result\":\"ok\"}";
+        }
+        else
+        {
+            ss << "{\"command\":\"" << command.c_str() << "\",\"result\":\"not available remotely\"}";
+        }
+    }
+    else
+    {
+        ss << "{\"result\":\"invalid command\"}";
+    }
+    return ss.str();
 }
 
 // display the list of console commands
@@ -66,6 +141,6 @@ void Console::help(void)
 {
     for (auto const& [command, resource] : commands)
     {
-        std::cout << command.c_str() << " - " << resource.first.c_str() << std::endl;
+        std::cout << command.c_str() << " - " << resource.description.c_str() << std::endl;
     }
 }
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "Platform.h"
 #include <string>
 #include <map>
 #include <unordered_map>
 #include <functional>
+#include <atomic>
+#include <mutex>
 
 enum class LogLevel
 {
@@ -25,9 +28,13 @@ public:
     static Console& getInstance();
     void log(LogLevel level, std::string message);
     void handler(void);
+    void execute(std::string command);
     bool isQuitRequest(void) const { return quitRequest; }
-    void registerCommand(std::string command, std::string description, std::function<void(void)> action);
-    void quit(void) { quitRequest = true; }
+    void registerCommand(std::string command, std::string description, std::function<void(void)> action, bool isRemote = false);  // isRemote: the command may be executed by remote clients (it must not block)
+    void registerQuery(std::string command, std::function<std::string(void)> query);     // query returns JSON snapshot for remote clients
+    std::string executeRemoteCommand(std::string command);      // executes command received from remote client and returns JSON response
+    Event& getQuitEvent(void) { return quitEvent; }     // signaled when quit is requested
+    void quit(void);
     void help(void);
 private:
     Console();
@@ -41,6 +48,15 @@ private:
         {LogLevel::Info, "info"},
         {LogLevel::Debug, "debug"}
     };
-    bool quitRequest{ false };
-    std::map < std::string, std::pair<std::string, std::function<void(void)>>> commands;
+    std::atomic<bool> quitRequest{ false };
+    Event quitEvent{ true };    // wakes up all threads waiting for events
+    struct Command
+    {
+        std::string description;
+        std::function<void(void)> action;
+        bool isRemote;      // allowed for remote clients
+    };
+    std::map<std::string, Command> commands;
+    std::map<std::string, std::function<std::string(void)>> queries;
+    std::mutex outputMutex;     // console output from many threads
 };
@@ -1,17 +1,63 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
+// buffer fields are not aligned - memcpy is compiled to a single unaligned load/store on all platforms
 template<typename T> void placeData(T data, uint8_t*& pBuffer)
 {
-    //memcpy(pBuffer, &variable, sizeof(T));
-    *reinterpret_cast<T*>(pBuffer) = data;
+    memcpy(pBuffer, &data, sizeof(T));
     pBuffer += sizeof(T);
 }
 
 template<typename T> T parseData(uint8_t*& pBuffer)
 {
-    T data = *reinterpret_cast<T*>(pBuffer);
+    T data;
+    memcpy(&data, pBuffer, sizeof(T));
     pBuffer += sizeof(T);
     return data;
 }
+
+// signed 16-bit fixed-point (Q-format) wire representation of a value with declared range
+// the number of fractional bits is the largest one which keeps the range within int16
+class FixedPoint16
+{
+public:
+    constexpr FixedPoint16(double range) : fractionalBits(getFractionalBits(range)), scale(static_cast<double>(1 << getFractionalBits(range))) {}
+    constexpr int16_t encode(double value) const    // rounded to nearest and saturated
+    {
+        double scaled = value * scale;
+        scaled = scaled < 0 ? scaled - 0.5 : scaled + 0.5;
+        return scaled >= 32767.0 ? 32767 : (scaled <= -32768.0 ? -32768 : static_cast<int16_t>(scaled));
+    }
+    constexpr double decode(int16_t raw) const { return raw / scale; }
+    constexpr double getResolution(void) const { return 1.0 / scale; }
+    constexpr int getFractionalBits(void) const { return fractionalBits; }
+    constexpr bool isRoundTripExact(double value) const     // decoded value differs at most by a half of the resolution
+    {
+        double error = decode(encode(value)) - value;
+        return (error <= getResolution() / 2) && (error >= -getResolution() / 2);
+    }
+private:
+    static constexpr int getFractionalBits(double range)
+    {
+        int bits = 15;
+        while ((bits > 0) && (range * (1 << bits) > 32767.0))
+        {
+            bits--;
+        }
+        return bits;
+    }
+    int fractionalBits;
+    double scale;       // 2^fractionalBits
+};
+
+template<typename T> void placeFixed(T data, const FixedPoint16& format, uint8_t*& pBuffer)
+{
+    placeData<int16_t>(format.encode(static_cast<double>(data)), pBuffer);
+}
+
+template<typename T> T parseFixed(const FixedPoint16& format, uint8_t*& pBuffer)
+{
+    return static_cast<T>(format.decode(parseData<int16_t>(pBuffer)));
+}
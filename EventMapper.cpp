@@ -0,0 +1,99 @@
+#include "EventMapper.h"
+
+EventMapper::EventMapper()
+{
+    clearTable();
+}
+
+// remove all input to event mappings
+void EventMapper::clear(void)
+{
+    std::lock_guard<std::mutex> lock(eventMutex);
+    clearTable();
+}
+
+// map the input bit edge to the client event
+void EventMapper::addMapping(uint8_t bitPosition, EdgeTrigger trigger, uint32_t eventID)
+{
+    std::lock_guard<std::mutex> lock(eventMutex);
+    addToTable({ bitPosition, trigger, eventID });
+}
+
+// replace all mappings - the inputs are never processed with a partial table
+void EventMapper::setMappings(const std::vector<Mapping>& mappings)
+{
+    std::lock_guard<std::mutex> lock(eventMutex);
+    clearTable();
+    for (auto const& mapping : mappings)
+    {
+        addToTable(mapping);
+    }
+}
+
+void EventMapper::clearTable(void)
+{
+    for (uint8_t bitPosition = 0; bitPosition < NumberOfInputs; bitPosition++)
+    {
+        pressEvents[bitPosition] = releaseEvents[bitPosition] = NoEvent;
+    }
+    pressMask = releaseMask = 0;
+    isFirstReport = true;
+    pendingEvents.clear();
+}
+
+void EventMapper::addToTable(const Mapping& mapping)
+{
+    if (mapping.bitPosition >= NumberOfInputs)
+    {
+        return;
+    }
+    if (mapping.trigger == EdgeTrigger::Press)
+    {
+        pressEvents[mapping.bitPosition] = mapping.eventID;
+        pressMask |= (1u << mapping.bitPosition);
+    }
+    else
+    {
+        releaseEvents[mapping.bitPosition] = mapping.eventID;
+        releaseMask |= (1u << mapping.bitPosition);
+    }
+}
+
+// detect edges of all inputs at once and queue the mapped events
+void EventMapper::processInputs(uint32_t inputs)
+{
+    std::lock_guard<std::mutex> lock(eventMutex);
+    if (isFirstReport)
+    {
+        // the current state of switches must not trigger events
+        lastInputs = inputs;
+        isFirstReport = false;
+        return;
+    }
+
+    uint32_t changed = inputs ^ lastInputs;
+    lastInputs = inputs;
+    uint32_t pressed = changed & inputs & pressMask;
+    uint32_t released = changed & ~inputs & releaseMask;
+    for (uint8_t bitPosition = 0; (pressed | released) != 0; bitPosition++, pressed >>= 1, released >>= 1)
+    {
+        if (pressed & 1)
+        {
+            pendingEvents.push_back(pressEvents[bitPosition]);
+            triggeredCount++;
+        }
+        if (released & 1)
+        {
+            pendingEvents.push_back(releaseEvents[bitPosition]);
+            triggeredCount++;
+        }
+    }
+}
+// move all queued events to the given vector
+bool EventMapper::takePendingEvents(std::vector<uint32_t>& events)
+{
+    events.clear();
+    std::lock_guard<std::mutex> lock(eventMutex);
+    pendingEvents.swap(events);
+    return !events.empty();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+enum class EdgeTrigger
+{
+    Press,      // event triggered when the input bit changes 0->1
+    Release     // event triggered when the input bit changes 1->0
+};
+
+// maps bits of the joystick input bitfield to simulator client events
+class EventMapper
+{
+public:
+    struct Mapping
+    {
+        uint8_t bitPosition;
+        EdgeTrigger trigger;
+        uint32_t eventID;
+    };
+    EventMapper();
+    void clear(void);       // removes all mappings
+    void addMapping(uint8_t bitPosition, EdgeTrigger trigger, uint32_t eventID);
+    void setMappings(const std::vector<Mapping>& mappings);     // replaces all mappings at once
+    void processInputs(uint32_t inputs);        // detects edges of all inputs and queues mapped events
+    bool takePendingEvents(std::vector<uint32_t>& events);      // moves queued events to the vector; returns true if any
+    uint32_t getTriggeredCount(void) const { return triggeredCount; }
+    static const uint8_t NumberOfInputs = 32;
+private:
+    static const uint32_t NoEvent = UINT32_MAX;
+    void clearTable(void);
+    void addToTable(const Mapping& mapping);
+    uint32_t pressEvents[NumberOfInputs];       // event ID for every input on press
+    uint32_t releaseEvents[NumberOfInputs];     // event ID for every input on release
+    uint32_t pressMask{ 0 };        // inputs with an event on press
+    uint32_t releaseMask{ 0 };      // inputs with an event on release
+    uint32_t lastInputs{ 0 };
+    bool isFirstReport{ true };     // the first report sets the initial state only
+    std::mutex eventMutex;      // the tables are rewritten by the simulator thread while the joystick thread processes inputs
+    std::vector<uint32_t> pendingEvents;    // events waiting for transmission
+    std::atomic<uint32_t> triggeredCount{ 0 };   // number of triggered events
+};
@@ -0,0 +1,164 @@
+#include "FaultInjector.h"
+#include "Console.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+const std::chrono::milliseconds FaultInjector::DelayTime{ 50 };
+
+FaultInjector& FaultInjector::getInstance()
+{
+    static FaultInjector instance;
+    return instance;
+}
+
+// activate the fault for the given time
+void FaultInjector::inject(Fault fault, std::chrono::milliseconds duration)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    FaultRecord& record = records[fault];
+    record.isPending = true;
+    record.isDetected = false;
+    record.startTime = std::chrono::steady_clock::now();
+    record.endTime = record.startTime + duration;
+    record.injectionCount++;
+    activeMask |= 1u << fault;
+    pendingMask |= 1u << fault;
+    Console::getInstance().log(LogLevel::Info, std::string("fault injected: ") + faultNames[fault]);
+}
+
+// check whether the fault is active now; expired faults are deactivated
+bool FaultInjector::isActive(Fault fault)
+{
+    if ((activeMask & (1u << fault)) == 0)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(recordMutex);
+    if (std::chrono::steady_clock::now() < records[fault].endTime)
+    {
+        return true;
+    }
+    activeMask &= ~(1u << fault);
+    return false;
+}
+
+// the application noticed a problem on the link
+void FaultInjector::reportDetected(Link link)
+{
+    if (pendingMask == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(recordMutex);
+    auto now = std::chrono::steady_clock::now();
+    for (int fault = 0; fault < NumberOfFaults; fault++)
+    {
+        FaultRecord& record = records[fault];
+        if (record.isPending && !record.isDetected && (getLink(static_cast<Fault>(fault)) == link))
+        {
+            record.isDetected = true;
+            double detectTime = std::chrono::duration<double, std::milli>(now - record.startTime).count();
+            record.detectionCount++;
+            record.detectTimeSum += detectTime;
+            record.detectTimeMax = (std::max)(record.detectTimeMax, detectTime);
+        }
+    }
+}
+
+// valid data received on the link - faults which have already ended are recovered
+void FaultInjector::reportRecovered(Link link)
+{
+    if (pendingMask == 0)
+    {
+        // fast path for every valid data frame
+        return;
+    }
+    std::lock_guard<std::mutex> lock(recordMutex);
+    auto now = std::chrono::steady_clock::now();
+    for (int fault = 0; fault < NumberOfFaults; fault++)
+    {
+        FaultRecord& record = records[fault];
+        if (record.isPending && (now >= record.endTime) && (getLink(static_cast<Fault>(fault)) == link))
+        {
+            record.isPending = false;
+            pendingMask &= ~(1u << fault);
+            double recoverTime = std::chrono::duration<double, std::milli>(now - record.endTime).count();
+            record.recoveryCount++;
+            record.recoverTimeSum += recoverTime;
+            record.recoverTimeMax = (std::max)(record.recoverTimeMax, recoverTime);
+        }
+    }
+}
+
+// inject all faults one after another and wait for the recovery of every one
+// both links should be connected before the run
+void FaultInjector::runScenarios(void)
+{
+    for (int fault = 0; (fault < NumberOfFaults) && !Console::getInstance().isQuitRequest(); fault++)
+    {
+        inject(static_cast<Fault>(fault), ScenarioFaultDuration);
+        auto deadline = std::chrono::steady_clock::now() + ScenarioFaultDuration + ScenarioTimeout;
+        bool isPending = true;
+        while (isPending && (std::chrono::steady_clock::now() < deadline) && !Console::getInstance().isQuitRequest())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::lock_guard<std::mutex> lock(recordMutex);
+            isPending = records[fault].isPending;
+        }
+        if (isPending)
+        {
+            std::lock_guard<std::mutex> lock(recordMutex);
+            records[fault].isPending = false;
+            pendingMask &= ~(1u << fault);
+            Console::getInstance().log(LogLevel::Warning, std::string("no recovery after fault: ") + faultNames[fault]);
+        }
+    }
+    displayResults();
+}
+
+uint32_t FaultInjector::getDetectionCount(Fault fault)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return records[fault].detectionCount;
+}
+
+uint32_t FaultInjector::getRecoveryCount(Fault fault)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return records[fault].recoveryCount;
+}
+
+double FaultInjector::getDetectTimeMax(Fault fault)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return records[fault].detectTimeMax;
+}
+
+double FaultInjector::getRecoverTimeMax(Fault fault)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    return records[fault].recoverTimeMax;
+}
+
+// display time-to-detect and time-to-recover of all faults
+// formatted in a local stream, so the number format of std::cout is not changed
+void FaultInjector::displayResults(void)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    std::stringstream ss;
+    ss << "========== fault injection results [ms] ==========" << std::endl;
+    ss << std::left << std::setw(16) << "fault" << std::right << std::setw(8) << "inject" << std::setw(8) << "detect" << std::setw(10) << "avg" << std::setw(10) << "max"
+        << std::setw(9) << "recover" << std::setw(10) << "avg" << std::setw(10) << "max" << std::endl;
+    ss << std::fixed << std::setprecision(1);
+    for (int fault = 0; fault < NumberOfFaults; fault++)
+    {
+        const FaultRecord& record = records[fault];
+        ss << std::left << std::setw(16) << faultNames[fault] << std::right << std::setw(8) << record.injectionCount;
+        ss << std::setw(8) << record.detectionCount << std::setw(10) << (record.detectionCount ? record.detectTimeSum / record.detectionCount : 0) << std::setw(10) << record.detectTimeMax;
+        ss << std::setw(9) << record.recoveryCount << std::setw(10) << (record.recoveryCount ? record.recoverTimeSum / record.recoveryCount : 0) << std::setw(10) << record.recoverTimeMax << std::endl;
+    }
+    std::cout << ss.str();
+}
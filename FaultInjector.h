@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+// fault hooks are compiled only in builds with FAULT_INJECTION defined
+#ifdef FAULT_INJECTION
+#define FAULT_ACTIVE(fault) FaultInjector::getInstance().isActive(FaultInjector::fault)
+#define FAULT_DETECTED(link) FaultInjector::getInstance().reportDetected(FaultInjector::link)
+#define FAULT_RECOVERED(link) FaultInjector::getInstance().reportRecovered(FaultInjector::link)
+#else
+#define FAULT_ACTIVE(fault) false
+#define FAULT_DETECTED(link)
+#define FAULT_RECOVERED(link)
+#endif
+
+// injects transport faults into the joystick and simulator links and measures how fast the application reacts
+class FaultInjector
+{
+public:
+    enum Fault
+    {
+        UsbDropReport,      // received joystick reports are discarded
+        UsbDelayReport,     // every received joystick report is delayed
+        UsbShortReport,     // received joystick reports are truncated
+        UsbDisconnect,      // joystick disappears from the bus
+        UsbSendError,       // feedback reports cannot be written
+        SimDropMessage,     // SimConnect messages are discarded
+        SimGarbageID,       // SimConnect messages arrive with unknown dwID
+        SimDisconnect,      // SimConnect server closes the connection
+        SimStall,           // SimConnect server stops responding
+        NumberOfFaults
+    };
+    enum Link
+    {
+        Joystick,
+        Simulator
+    };
+    FaultInjector(FaultInjector const&) = delete;
+    FaultInjector& operator=(FaultInjector const&) = delete;
+    static FaultInjector& getInstance();
+    void inject(Fault fault, std::chrono::milliseconds duration);    // activates the fault for the given time
+    bool isActive(Fault fault);
+    void reportDetected(Link link);     // the application noticed a problem on the link
+    void reportRecovered(Link link);    // valid data received on the link
+    void runScenarios(void);    // injects all faults one after another and waits for recovery
+    void displayResults(void);
+    uint32_t getDetectionCount(Fault fault);
+    uint32_t getRecoveryCount(Fault fault);
+    double getDetectTimeMax(Fault fault);       // [ms]
+    double getRecoverTimeMax(Fault fault);      // [ms]
+    static const std::chrono::milliseconds DelayTime;      // delay of every report during UsbDelayReport
+    static const size_t ShortReportSize = 8;    // bytes left in a report during UsbShortReport
+private:
+    FaultInjector() {}
+    struct FaultRecord
+    {
+        bool isPending{ false };    // injected and not recovered yet
+        std::chrono::steady_clock::time_point startTime;
+        std::chrono::steady_clock::time_point endTime;
+        bool isDetected{ false };
+        uint32_t injectionCount{ 0 };
+        uint32_t detectionCount{ 0 };
+        uint32_t recoveryCount{ 0 };
+        double detectTimeSum{ 0 };      // [ms] from the fault start
+        double detectTimeMax{ 0 };
+        double recoverTimeSum{ 0 };     // [ms] from the fault end
+        double recoverTimeMax{ 0 };
+    };
+    Link getLink(Fault fault) const { return fault < SimDropMessage ? Joystick : Simulator; }
+    std::mutex recordMutex;
+    FaultRecord records[NumberOfFaults];
+    std::atomic<uint32_t> activeMask{ 0 };      // bit set for every active fault - fast path of isActive
+    std::atomic<uint32_t> pendingMask{ 0 };     // bit set for every fault not recovered yet
+    const char* faultNames[NumberOfFaults] = { "usb drop", "usb delay", "usb short", "usb disconnect", "usb send error",
+        "sim drop", "sim garbage id", "sim disconnect", "sim stall" };
+    const std::chrono::milliseconds ScenarioFaultDuration{ 1000 };
+    const std::chrono::milliseconds ScenarioTimeout{ 10000 };   // time to wait for recovery after the fault end
+};
@@ -0,0 +1,107 @@
+#include "HealthMonitor.h"
+#include "Console.h"
+#include "Platform.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+HealthMonitor& HealthMonitor::getInstance()
+{
+    static HealthMonitor instance;
+    return instance;
+}
+
+HealthMonitor::HealthMonitor()
+{
+    startTime = lastSampleTime = SessionClock::now();
+    addGauge("private memory [kB]", getPrivateMemorySize, 50 * 1024);
+    addGauge("handles", getHandleCount, 100);
+}
+
+void HealthMonitor::addGauge(std::string name, std::function<size_t(void)> getValue, size_t allowedGrowth)
+{
+    std::lock_guard<std::mutex> lock(gaugeMutex);
+    Gauge gauge;
+    gauge.name = name;
+    gauge.getValue = getValue;
+    gauge.allowedGrowth = allowedGrowth;
+    gauges.push_back(gauge);
+}
+
+// sample all gauges once per sample period; the first sample after the warm-up time becomes the baseline
+void HealthMonitor::service(void)
+{
+    auto now = SessionClock::now();
+    if (now - lastSampleTime < SamplePeriod)
+    {
+        return;
+    }
+    lastSampleTime = now;
+    bool setBaseline = !isBaselineSet && (now - startTime >= WarmupTime);
+
+    std::lock_guard<std::mutex> lock(gaugeMutex);
+    sampleCount++;
+    for (auto& gauge : gauges)
+    {
+        gauge.value = gauge.getValue();
+        gauge.peak = (std::max)(gauge.peak, gauge.value);
+        if (setBaseline)
+        {
+            gauge.baseline = gauge.value;
+        }
+        else if (isBaselineSet)
+        {
+            bool isGrown = gauge.value > gauge.baseline + gauge.allowedGrowth;
+            if (isGrown && !gauge.isWarned)
+            {
+                std::stringstream ss;
+                ss << gauge.name.c_str() << " grew from " << gauge.baseline << " to " << gauge.value;
+                Console::getInstance().log(LogLevel::Warning, ss.str());
+            }
+            gauge.isWarned = isGrown;
+        }
+    }
+    isBaselineSet |= setBaseline;
+}
+
+void HealthMonitor::display(void)
+{
+    std::lock_guard<std::mutex> lock(gaugeMutex);
+    std::cout << "========== Health ==========" << std::endl;
+    std::cout << "uptime [h] = " << std::chrono::duration<double, std::ratio<3600>>(SessionClock::now() - startTime).count() << std::endl;
+    std::cout << "samples = " << sampleCount << (isBaselineSet ? "" : " (warming up)") << std::endl;
+    for (auto& gauge : gauges)
+    {
+        std::cout << gauge.name.c_str() << " = " << gauge.value << ", baseline = " << gauge.baseline << ", peak = " << gauge.peak << (gauge.isWarned ? " GROWING" : "") << std::endl;
+    }
+}
+
+std::string HealthMonitor::getJson(void)
+{
+    std::lock_guard<std::mutex> lock(gaugeMutex);
+    std::stringstream ss;
+    ss << "{\"uptime\":" << std::chrono::duration<double>(SessionClock::now() - startTime).count();
+    ss << ",\"baselineSet\":" << (isBaselineSet ? "true" : "false");
+    ss << ",\"gauges\":[";
+    for (size_t index = 0; index < gauges.size(); index++)
+    {
+        ss << (index ? "," : "") << "{\"name\":\"" << gauges[index].name.c_str() << "\",\"value\":" << gauges[index].value;
+        ss << ",\"baseline\":" << gauges[index].baseline << ",\"peak\":" << gauges[index].peak << ",\"growing\":" << (gauges[index].isWarned ? "true" : "false") << "}";
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+std::vector<std::string> HealthMonitor::getGrowingGauges(void)
+{
+    std::lock_guard<std::mutex> lock(gaugeMutex);
+    std::vector<std::string> names;
+    for (auto& gauge : gauges)
+    {
+        if (gauge.isWarned)
+        {
+            names.push_back(gauge.name);
+        }
+    }
+    return names;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <mutex>
+
+// samples process resources and container sizes over long sessions and warns about their growth
+class HealthMonitor
+{
+public:
+    HealthMonitor(HealthMonitor const&) = delete;
+    HealthMonitor& operator=(HealthMonitor const&) = delete;
+    static HealthMonitor& getInstance();
+    void addGauge(std::string name, std::function<size_t(void)> getValue, size_t allowedGrowth);  // getValue is called in the thread calling service()
+    void service(void);     // samples all gauges when the sample period has elapsed
+    void display(void);
+    std::string getJson(void);
+    std::vector<std::string> getGrowingGauges(void);    // names of gauges above their allowed growth
+private:
+    HealthMonitor();
+    struct Gauge
+    {
+        std::string name;
+        std::function<size_t(void)> getValue;
+        size_t allowedGrowth;   // warning when the value exceeds the baseline by more than this
+        size_t value{ 0 };
+        size_t baseline{ 0 };   // value after the warm-up time
+        size_t peak{ 0 };
+        bool isWarned{ false };
+    };
+    std::mutex gaugeMutex;
+    std::vector<Gauge> gauges;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point lastSampleTime;
+    bool isBaselineSet{ false };
+    uint32_t sampleCount{ 0 };
+    const std::chrono::seconds SamplePeriod{ 10 };
+    const std::chrono::seconds WarmupTime{ 120 };     // connections and caches settle before the baseline is taken
+};
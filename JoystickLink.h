@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ReportLayout.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+// vendor defined input report - the contract with the joystick firmware
+// byte 0: report ID, bytes 1-4: float yoke X, bytes 5-8: float throttle
+// from report version 2: bytes 9-12: uint32 buttons, byte 13: report version; older firmware leaves these bytes undefined
+struct VendorReport
+{
+    static const size_t ButtonsOffset = 9;
+    static const size_t VersionOffset = 13;
+    static const uint8_t ButtonsVersion = 2;    // first report version with the buttons
+};
+
+// joystick device as seen by the simulator logic
+// implemented by the USB HID link and by the stand-in joystick of the headless build
+class JoystickLink
+{
+public:
+    virtual ~JoystickLink() {}
+    virtual bool sendData(uint8_t* dataToSend) = 0;     // sends the feedback frame to the device
+    virtual bool isConnectionOpen(void) const = 0;
+    virtual const ReportLayout& getReportLayout(void) const = 0;    // layout of the input report found on the device
+    virtual uint32_t getReportLayoutVersion(void) const = 0;        // incremented with every new layout
+    void setParseFunction(std::function<void(std::vector<uint8_t>)> fn) { parseCallback = fn; }    // called with every received input report
+protected:
+    std::function<void(std::vector<uint8_t>)> parseCallback{ nullptr };
+};
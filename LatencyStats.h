@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// statistics of thread wake-up latency (time between the planned and the actual wake-up)
+class LatencyStats
+{
+public:
+    void addSample(std::chrono::steady_clock::duration latency);
+    void reset(void);
+    void display(std::string name) const;
+    uint32_t getCount(void) const { return sampleCount; }
+    int64_t getAverage(void) const;     // [us]
+private:
+    static const size_t NumberOfBins = 7;
+    const int64_t BinLimits[NumberOfBins - 1] = { 100, 500, 1000, 2000, 5000, 10000 };   // upper bin limits [us]
+    std::atomic<uint32_t> sampleCount{ 0 };
+    std::atomic<int64_t> latencySum{ 0 };     // [us]
+    std::atomic<int64_t> latencyMax{ 0 };     // [us]
+    std::atomic<uint32_t> bins[NumberOfBins]{};
+};
+
+inline void LatencyStats::addSample(std::chrono::steady_clock::duration latency)
+{
+    int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    if (latencyUs < 0)
+    {
+        latencyUs = 0;
+    }
+    size_t bin = 0;
+    while ((bin < NumberOfBins - 1) && (latencyUs >= BinLimits[bin]))
+    {
+        bin++;
+    }
+    bins[bin]++;
+    sampleCount++;
+    latencySum += latencyUs;
+    if (latencyUs > latencyMax)
+    {
+        latencyMax = latencyUs;
+    }
+}
+
+inline void LatencyStats::reset(void)
+{
+    sampleCount = 0;
+    latencySum = 0;
+    latencyMax = 0;
+    for (auto& bin : bins)
+    {
+        bin = 0;
+    }
+}
+
+inline int64_t LatencyStats::getAverage(void) const
+{
+    uint32_t count = sampleCount;
+    return count ? latencySum / count : 0;
+}
+
+inline void LatencyStats::display(std::string name) const
+{
+    std::cout << "========== " << name.c_str() << " wake-up latency ==========" << std::endl;
+    std::cout << "samples = " << sampleCount << std::endl;
+    std::cout << "average [us] = " << getAverage() << std::endl;
+    std::cout << "max [us] = " << latencyMax << std::endl;
+    for (size_t bin = 0; bin < NumberOfBins; bin++)
+    {
+        if (bin < NumberOfBins - 1)
+        {
+            std::cout << "< " << BinLimits[bin] << " us : " << bins[bin] << std::endl;
+        }
+        else
+        {
+            std::cout << ">= " << BinLimits[bin - 1] << " us : " << bins[bin] << std::endl;
+        }
+    }
+}
@@ -4,28 +4,283 @@
 #include "Console.h"
 #include "USB.h"
 #include "Simulator.h"
+#include "CommandServer.h"
+#include "ThreadConfig.h"
+#include "Reactor.h"
+#include "FaultInjector.h"
+#include "Profiler.h"
+#include "HealthMonitor.h"
+#include "BackgroundTask.h"
+#include <Psapi.h>
 #include <iostream>
 #include <thread>
 #include <functional>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
 
+// default joystick device; other devices are selected with --vid=, --pid= and --report=
 #define VENDOR_ID   0x483
 #define PRODUCT_ID  0x5712  // HID joystick + 2
 #define REPORT_ID   0x02
 
-int main()
+// display wake-up latency of the I/O threads (of the reactor thread in reactor mode)
+void displayJitter(USBHID* pJoystickLink, Reactor* pReactor, bool reactorMode)
+{
+    if (reactorMode)
+    {
+        pReactor->getWakeupLatency().display("reactor");
+    }
+    else
+    {
+        pJoystickLink->getWakeupLatency().display("USB");
+        Simulator::getInstance().getWakeupLatency().display("simulator");
+    }
+}
+
+// measure wake-up latency of the I/O threads with all processors loaded by busy threads
+// it runs as a background task, so the reactor keeps servicing the links during the measurement
+void jitterBenchmark(USBHID* pJoystickLink, Reactor* pReactor, bool reactorMode)
+{
+    const auto BenchmarkTime = std::chrono::seconds(5);
+    unsigned int numberOfThreads = std::thread::hardware_concurrency();
+    std::cout << "loading " << numberOfThreads << " processors for " << BenchmarkTime.count() << " s" << std::endl;
+    pJoystickLink->getWakeupLatency().reset();
+    Simulator::getInstance().getWakeupLatency().reset();
+    pReactor->getWakeupLatency().reset();
+
+    std::atomic<bool> stopLoad{ false };
+    std::vector<std::thread> loadThreads;
+    for (unsigned int index = 0; index < numberOfThreads; index++)
+    {
+        loadThreads.emplace_back([&stopLoad]()
+            {
+                volatile uint64_t counter = 0;
+                while (!stopLoad)
+                {
+                    counter++;
+                }
+            });
+    }
+    std::this_thread::sleep_for(BenchmarkTime);
+    stopLoad = true;
+    for (auto& loadThread : loadThreads)
+    {
+        loadThread.join();
+    }
+
+    displayJitter(pJoystickLink, pReactor, reactorMode);
+}
+
+// display CPU time used by the process since its start
+void displayCpuUsage(std::chrono::steady_clock::time_point startTime)
+{
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        auto toSeconds = [](FILETIME time) { return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7; };
+        double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        double cpuTime = toSeconds(kernelTime) + toSeconds(userTime);
+        std::cout << "wall time [s] = " << wallTime << std::endl;
+        std::cout << "kernel time [s] = " << toSeconds(kernelTime) << std::endl;
+        std::cout << "user time [s] = " << toSeconds(userTime) << std::endl;
+        std::cout << "CPU usage [%] = " << (wallTime > 0 ? 100.0 * cpuTime / wallTime : 0) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
 {
     Console::getInstance().log(LogLevel::Always, "MS SimConnect client v1.0");
     Console::getInstance().log(LogLevel::Always, "type 'help' for the list of commands");
 
-    USBHID joystickLink(VENDOR_ID, PRODUCT_ID, REPORT_ID);
+    USHORT vendorID = VENDOR_ID;
+    USHORT productID = PRODUCT_ID;
+    uint8_t reportID = REPORT_ID;
+    bool realTime = false;
+    bool reactorMode = false;
+    // real-time configuration; every option of it also enables --realtime
+    ProcessParameters processParameters{ HIGH_PRIORITY_CLASS, 64 * 1024 * 1024, 256 * 1024 * 1024, 1 };
+    ThreadParameters usbThreadParameters{ THREAD_PRIORITY_TIME_CRITICAL, ThreadConfig::getInstance().getProcessorFromEnd(0) };
+    ThreadParameters simulatorThreadParameters{ THREAD_PRIORITY_HIGHEST, ThreadConfig::getInstance().getProcessorFromEnd(1) };
+    for (int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        std::string argument(argv[argIndex]);
+        if (argument == "--realtime")
+        {
+            realTime = true;
+        }
+        else if (argument == "--reactor")
+        {
+            reactorMode = true;
+        }
+        else if (argument.rfind("--priorityclass=", 0) == 0)
+        {
+            // priority class of the process: normal, abovenormal, high or realtime
+            if (ThreadConfig::getPriorityClass(argument.substr(16), processParameters.priorityClass))
+            {
+                realTime = true;
+            }
+            else
+            {
+                Console::getInstance().log(LogLevel::Warning, "unknown priority class: " + argument.substr(16));
+            }
+        }
+        else if (argument.rfind("--workingset=", 0) == 0)
+        {
+            // minimum and maximum working set of the process [MB], e.g. --workingset=64,256; 0,0 = do not change
+            char* pEnd;
+            SIZE_T minSize = strtoul(argument.c_str() + 13, &pEnd, 10);
+            SIZE_T maxSize = (*pEnd == ',') ? strtoul(pEnd + 1, nullptr, 10) : 0;
+            if (minSize <= maxSize)
+            {
+                processParameters.minWorkingSetSize = minSize * 1024 * 1024;
+                processParameters.maxWorkingSetSize = maxSize * 1024 * 1024;
+                realTime = true;
+            }
+            else
+            {
+                Console::getInstance().log(LogLevel::Warning, "invalid working set sizes: " + argument.substr(13));
+            }
+        }
+        else if (argument.rfind("--usbaffinity=", 0) == 0)
+        {
+            // processor affinity mask of the USB thread (of the reactor thread in reactor mode) (hexadecimal); 0 = any processor
+            usbThreadParameters.affinityMask = static_cast<DWORD_PTR>(strtoull(argument.c_str() + 14, nullptr, 16));
+            realTime = true;
+        }
+        else if (argument.rfind("--simaffinity=", 0) == 0)
+        {
+            // processor affinity mask of the simulator thread (hexadecimal); 0 = any processor
+            simulatorThreadParameters.affinityMask = static_cast<DWORD_PTR>(strtoull(argument.c_str() + 14, nullptr, 16));
+            realTime = true;
+        }
+        else if (argument.rfind("--usbpriority=", 0) == 0)
+        {
+            // priority of the USB thread (of the reactor thread in reactor mode), e.g. 15 = time critical
+            usbThreadParameters.priority = atoi(argument.c_str() + 14);
+            realTime = true;
+        }
+        else if (argument.rfind("--simpriority=", 0) == 0)
+        {
+            // priority of the simulator thread, e.g. 2 = highest
+            simulatorThreadParameters.priority = atoi(argument.c_str() + 14);
+            realTime = true;
+        }
+        else if (argument == "--polling")
+        {
+            Simulator::getInstance().setEventDrivenDispatch(false);
+        }
+        else if (argument.rfind("--vid=", 0) == 0)
+        {
+            // USB vendor ID of the joystick (hexadecimal)
+            vendorID = static_cast<USHORT>(strtoul(argument.c_str() + 6, nullptr, 16));
+        }
+        else if (argument.rfind("--pid=", 0) == 0)
+        {
+            // USB product ID of the joystick (hexadecimal)
+            productID = static_cast<USHORT>(strtoul(argument.c_str() + 6, nullptr, 16));
+        }
+        else if (argument.rfind("--report=", 0) == 0)
+        {
+            // input report ID of the joystick collection; 0 = device without report IDs
+            reportID = static_cast<uint8_t>(strtoul(argument.c_str() + 9, nullptr, 0));
+        }
+        else if (argument == "--traffic")
+        {
+            // sweeps of AI and multiplayer traffic around the user aircraft
+            Simulator::getInstance().setTrafficEnabled(true);
+        }
+        else if (argument.rfind("--simtimeout=", 0) == 0)
+        {
+            // deadline of simulator data [ms]
+            Simulator::getInstance().getWatchdog().setDeadline(Watchdog::SimData, std::chrono::milliseconds(atoi(argument.c_str() + 13)));
+        }
+        else if (argument.rfind("--joytimeout=", 0) == 0)
+        {
+            // deadline of joystick data [ms]; by default only the link loss expires it
+            Simulator::getInstance().getWatchdog().setDeadline(Watchdog::JoystickData, std::chrono::milliseconds(atoi(argument.c_str() + 13)));
+        }
+        else
+        {
+            Console::getInstance().log(LogLevel::Warning, "unknown option: " + argument);
+        }
+    }
+
+    USBHID joystickLink(vendorID, productID, reportID);
     Simulator::getInstance().setJoystickLink(&joystickLink);
     joystickLink.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
 
-    std::thread joystickLinkThread(&USBHID::handler, &joystickLink);
-    std::thread simulatorThread(&Simulator::handler, &Simulator::getInstance());
+    // all commands are registered before the command server thread starts reading the command table
+    CommandServer commandServer;
+    Reactor reactor(&joystickLink, &commandServer);
+    auto startTime = std::chrono::steady_clock::now();
+    Console::getInstance().registerCommand("cpu", "display CPU usage of the process", std::bind(displayCpuUsage, startTime));
+    Console::getInstance().registerCommand("health", "display resource usage and its growth over the session", std::bind(&HealthMonitor::display, &HealthMonitor::getInstance()));
+    Console::getInstance().registerQuery("health", std::bind(&HealthMonitor::getJson, &HealthMonitor::getInstance()));
+#ifdef PROFILING
+    // the export of the trace takes a while, so it runs in a background task also for remote clients
+    BackgroundTask traceStopTask("tracestop", std::bind(&Profiler::stop, &Profiler::getInstance()));
+    Console::getInstance().registerCommand("tracestart", "start capture of profiling zones", std::bind(&Profiler::start, &Profiler::getInstance()), true);
+    Console::getInstance().registerCommand("tracestop", "stop capture of profiling zones and write trace.json", std::bind(&BackgroundTask::start, &traceStopTask), true);
+#endif
+    Console::getInstance().registerCommand("jitter", "display wake-up latency of I/O threads", std::bind(displayJitter, &joystickLink, &reactor, reactorMode));
+    BackgroundTask jitterBenchmarkTask("jitterbench", std::bind(jitterBenchmark, &joystickLink, &reactor, reactorMode));
+    Console::getInstance().registerCommand("jitterbench", "measure wake-up latency of I/O threads under CPU load", std::bind(&BackgroundTask::start, &jitterBenchmarkTask), true);
+
+#ifdef FAULT_INJECTION
+    // the scenario runner has its own thread, so the links are serviced also in reactor mode
+    // a run requested while another one is active (e.g. from the console and a remote client) is refused
+    BackgroundTask faultScenarioTask("faultrun", std::bind(&FaultInjector::runScenarios, &FaultInjector::getInstance()));
+    Console::getInstance().registerCommand("faultrun", "inject all link faults one by one and measure recovery", std::bind(&BackgroundTask::start, &faultScenarioTask), true);
+    Console::getInstance().registerCommand("faults", "display fault injection results", std::bind(&FaultInjector::displayResults, &FaultInjector::getInstance()));
+#endif
+
+    std::thread commandServerThread(&CommandServer::handler, &commandServer);
+
+    if (realTime)
+    {
+        ThreadConfig::getInstance().setProcessParameters(processParameters);
+    }
+
+    std::chrono::steady_clock::time_point quitTime;
+    if (reactorMode)
+    {
+        // all handlers and remote commands in the main thread
+        if (realTime)
+        {
+            ThreadConfig::getInstance().setThreadParameters(GetCurrentThread(), usbThreadParameters, "reactor");
+            Console::getInstance().log(LogLevel::Info, "real-time thread configuration applied");
+        }
+        reactor.run();
+        quitTime = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        // every handler in its own thread
+        std::thread joystickLinkThread(&USBHID::handler, &joystickLink);
+        std::thread simulatorThread(&Simulator::handler, &Simulator::getInstance());
+
+        if (realTime)
+        {
+            // by default the I/O threads get priority over the simulator and are pinned to the last processors of the process
+            ThreadConfig::getInstance().setThreadParameters(joystickLinkThread.native_handle(), usbThreadParameters, "USB");
+            ThreadConfig::getInstance().setThreadParameters(simulatorThread.native_handle(), simulatorThreadParameters, "simulator");
+            Console::getInstance().log(LogLevel::Info, "real-time thread configuration applied");
+        }
+
+        Console::getInstance().handler();
 
-    Console::getInstance().handler();
+        quitTime = std::chrono::steady_clock::now();
+        simulatorThread.join();
+        joystickLinkThread.join();
+    }
 
-    simulatorThread.join();
-    joystickLinkThread.join();
+    commandServerThread.join();
+    ThreadConfig::getInstance().restoreProcessParameters();
+    std::stringstream ss;
+    ss << "threads stopped in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - quitTime).count() << " ms";
+    Console::getInstance().log(LogLevel::Debug, ss.str());
 }
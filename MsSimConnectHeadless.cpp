@@ -0,0 +1,101 @@
+// MsSimConnectHeadless.cpp : the client with the stand-in SimConnect server and the stand-in joystick.
+// It runs without the simulator and the USB device - on any system, in CI and on the bench.
+
+#include "Console.h"
+#include "Simulator.h"
+#include "HealthMonitor.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include <iostream>
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+// simulator frames of the stand-in server with the scripted flight
+void runStandInServer(StandInJoystick* pJoystick)
+{
+    SimConnectStandIn& server = SimConnectStandIn::getInstance();
+    initializeStandInFlight(server);
+    const auto FramePeriod = std::chrono::microseconds(1000000 / SimConnectStandIn::FramesPerSecond);
+    auto startTime = std::chrono::steady_clock::now();
+    auto frameTime = startTime;
+    Event* events[] = { &Console::getInstance().getQuitEvent() };
+    while (!Console::getInstance().isQuitRequest())
+    {
+        updateStandInFlight(std::chrono::duration<double>(frameTime - startTime).count(), server, *pJoystick);
+        server.runFrame();
+        frameTime += FramePeriod;
+        auto waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(frameTime - std::chrono::steady_clock::now());
+        Event::waitAny(events, 1, waitTime.count() > 0 ? waitTime : std::chrono::milliseconds(0));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Console::getInstance().log(LogLevel::Always, "MS SimConnect client v1.0 (headless)");
+
+    StandInJoystick::Format format = StandInJoystick::Format::Vendor;
+    int duration = 0;       // run time [s]; 0 = until the quit command
+    for (int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        std::string argument(argv[argIndex]);
+        if (argument == "--standard")
+        {
+            // joystick with the standard HID report layout
+            format = StandInJoystick::Format::Standard;
+        }
+        else if (argument == "--polling")
+        {
+            Simulator::getInstance().setEventDrivenDispatch(false);
+        }
+        else if (argument.rfind("--duration=", 0) == 0)
+        {
+            duration = atoi(argument.c_str() + 11);
+        }
+        else if (argument.rfind("--traffic=", 0) == 0)
+        {
+            // number of traffic objects around the user aircraft; the client sweeps the traffic
+            SimConnectStandIn::getInstance().setNumberOfTrafficObjects(static_cast<uint32_t>(atoi(argument.c_str() + 10)));
+            Simulator::getInstance().setTrafficEnabled(true);
+        }
+        else
+        {
+            Console::getInstance().log(LogLevel::Warning, "unknown option: " + argument);
+        }
+    }
+
+    StandInJoystick joystickLink(format);
+    Simulator::getInstance().setJoystickLink(&joystickLink);
+    joystickLink.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+    Console::getInstance().registerCommand("health", "display resource usage and its growth over the session", std::bind(&HealthMonitor::display, &HealthMonitor::getInstance()));
+
+    std::thread serverThread(runStandInServer, &joystickLink);
+    std::thread joystickLinkThread(&StandInJoystick::handler, &joystickLink);
+    std::thread simulatorThread(&Simulator::handler, &Simulator::getInstance());
+
+    if (duration > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(duration));
+        Console::getInstance().quit();
+    }
+    else
+    {
+        Console::getInstance().log(LogLevel::Always, "type 'help' for the list of commands");
+        Console::getInstance().handler();
+    }
+
+    simulatorThread.join();
+    joystickLinkThread.join();
+    serverThread.join();
+
+    // the run fails when the data did not flow in both directions
+    SimConnectStandIn& server = SimConnectStandIn::getInstance();
+    std::cout << "simulator frames = " << server.getFrameCount() << std::endl;
+    std::cout << "joystick reports = " << joystickLink.getReportCount() << std::endl;
+    std::cout << "joystick feedback frames = " << joystickLink.getFeedbackCount() << std::endl;
+    server.getDispatchLatency().display("dispatch");
+    return (server.getDispatchLatency().getCount() > 0) && (joystickLink.getFeedbackCount() > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
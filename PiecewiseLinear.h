@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// piecewise linear function given by breakpoints x0 y0 x1 y1 ... (x ascending); an unpaired last value is ignored
+// x outside the breakpoints gets the value of the nearest end point; fewer than 2 breakpoints return x unchanged
+inline float piecewiseLinear(const std::vector<float>& breakpoints, float x)
+{
+    size_t numberOfPoints = breakpoints.size() / 2;
+    if (numberOfPoints < 2)
+    {
+        return x;
+    }
+    size_t segment = 0;
+    while ((segment + 2 < numberOfPoints) && (x > breakpoints[2 * segment + 2]))
+    {
+        segment++;
+    }
+    float x0 = breakpoints[2 * segment];
+    float y0 = breakpoints[2 * segment + 1];
+    float x1 = breakpoints[2 * segment + 2];
+    float y1 = breakpoints[2 * segment + 3];
+    float ratio = (x1 > x0) ? (x - x0) / (x1 - x0) : 0.0f;
+    ratio = ratio < 0 ? 0 : (ratio > 1 ? 1 : ratio);
+    return y0 + (y1 - y0) * ratio;
+}
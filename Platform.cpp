@@ -0,0 +1,248 @@
+#include "Platform.h"
+
+#ifdef _WIN32
+#pragma comment(lib, "psapi.lib")
+#include <Windows.h>
+#include <Psapi.h>
+#include <iostream>
+#else
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#endif
+
+#ifdef _WIN32
+
+Event::Event(bool manualReset) :
+    manualReset(manualReset)
+{
+    handle = CreateEvent(NULL, manualReset, FALSE, NULL);
+}
+
+Event::~Event()
+{
+    CloseHandle(handle);
+}
+
+void Event::reset(void)
+{
+    ResetEvent(handle);
+}
+
+void Event::signal(NativeHandle handle)
+{
+    SetEvent(handle);
+}
+
+// automatic reset events are reset by WaitForMultipleObjects itself
+bool Event::consume(void)
+{
+    return true;
+}
+
+size_t Event::waitAny(Event* const events[], size_t numberOfEvents, std::chrono::milliseconds timeout)
+{
+    HANDLE handles[MaxWaitEvents];
+    numberOfEvents = numberOfEvents < MaxWaitEvents ? numberOfEvents : MaxWaitEvents;
+    for (size_t index = 0; index < numberOfEvents; index++)
+    {
+        handles[index] = events[index]->handle;
+    }
+    DWORD result = WaitForMultipleObjects(static_cast<DWORD>(numberOfEvents), handles, FALSE, static_cast<DWORD>(timeout.count()));
+    size_t index = result - WAIT_OBJECT_0;
+    return index < numberOfEvents ? index : Timeout;
+}
+
+uint32_t getThreadId(void)
+{
+    return GetCurrentThreadId();
+}
+
+size_t getPrivateMemorySize(void)
+{
+    PROCESS_MEMORY_COUNTERS_EX counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+    {
+        return counters.PrivateUsage / 1024;
+    }
+    return 0;
+}
+
+size_t getHandleCount(void)
+{
+    DWORD handleCount = 0;
+    GetProcessHandleCount(GetCurrentProcess(), &handleCount);
+    return handleCount;
+}
+
+// the blocking read of the console is aborted by cancelConsoleInput, which makes the stream fail
+bool readConsoleLine(std::string& line, Event& quitEvent)
+{
+    bool isRead = static_cast<bool>(std::getline(std::cin, line));
+    return isRead && (WaitForSingleObject(quitEvent.getNativeHandle(), 0) != WAIT_OBJECT_0);
+}
+
+void cancelConsoleInput(void)
+{
+    CancelIoEx(GetStdHandle(STD_INPUT_HANDLE), NULL);
+}
+
+#else
+
+Event::Event(bool manualReset) :
+    manualReset(manualReset)
+{
+    handle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+Event::~Event()
+{
+    close(handle);
+}
+
+// drain the counter; the descriptor stays readable until then
+void Event::reset(void)
+{
+    uint64_t value;
+    while (read(handle, &value, sizeof(value)) == sizeof(value))
+    {
+    }
+}
+
+void Event::signal(NativeHandle handle)
+{
+    // the counter cannot saturate in practice; the event is signaled anyway
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = write(handle, &one, sizeof(one));
+}
+
+bool Event::consume(void)
+{
+    uint64_t value;
+    return read(handle, &value, sizeof(value)) == sizeof(value);
+}
+
+// poll all descriptors; a signaled automatic reset event is consumed by the first waiter which reads it
+size_t Event::waitAny(Event* const events[], size_t numberOfEvents, std::chrono::milliseconds timeout)
+{
+    pollfd descriptors[MaxWaitEvents];
+    numberOfEvents = numberOfEvents < MaxWaitEvents ? numberOfEvents : MaxWaitEvents;
+    for (size_t index = 0; index < numberOfEvents; index++)
+    {
+        descriptors[index] = { events[index]->handle, POLLIN, 0 };
+    }
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true)
+    {
+        // rounded up, otherwise a wait shorter than 1 ms would return at once and a short timeout would spin
+        auto remainingTime = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        int result = poll(descriptors, static_cast<nfds_t>(numberOfEvents), remainingTime > 0 ? static_cast<int>(remainingTime) : 0);
+        if ((result < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return Timeout;
+        }
+        for (size_t index = 0; index < numberOfEvents; index++)
+        {
+            if ((descriptors[index].revents & POLLIN) && (events[index]->manualReset || events[index]->consume()))
+            {
+                return index;
+            }
+        }
+        // the signal has been taken by another thread - wait again
+    }
+}
+
+uint32_t getThreadId(void)
+{
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+}
+
+// resident anonymous memory is the equivalent of the Windows private usage
+size_t getPrivateMemorySize(void)
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key)
+    {
+        if (key == "RssAnon:")
+        {
+            size_t value = 0;
+            status >> value;
+            return value;
+        }
+        status.ignore(256, '\n');
+    }
+    return 0;
+}
+
+size_t getHandleCount(void)
+{
+    size_t handleCount = 0;
+    DIR* pDirectory = opendir("/proc/self/fd");
+    if (pDirectory)
+    {
+        while (readdir(pDirectory))
+        {
+            handleCount++;
+        }
+        closedir(pDirectory);
+        handleCount -= handleCount >= 3 ? 3 : handleCount;    // ".", ".." and the descriptor of the directory itself
+    }
+    return handleCount;
+}
+
+// standard input is polled together with the quit event, so the read never blocks past the quit request
+bool readConsoleLine(std::string& line, Event& quitEvent)
+{
+    static std::string pendingInput;    // input read beyond the last returned line
+    while (true)
+    {
+        size_t endOfLine = pendingInput.find('\n');
+        if (endOfLine != std::string::npos)
+        {
+            line = pendingInput.substr(0, endOfLine);
+            pendingInput.erase(0, endOfLine + 1);
+            return true;
+        }
+        pollfd descriptors[] = { { STDIN_FILENO, POLLIN, 0 }, { quitEvent.getNativeHandle(), POLLIN, 0 } };
+        int result = poll(descriptors, 2, -1);
+        if ((result < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if ((result < 0) || (descriptors[1].revents & POLLIN))
+        {
+            return false;
+        }
+        char buffer[256];
+        ssize_t length = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if ((length < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (length <= 0)
+        {
+            // end of input; the last line may be unterminated
+            line.swap(pendingInput);
+            pendingInput.clear();
+            return !line.empty();
+        }
+        pendingInput.append(buffer, static_cast<size_t>(length));
+    }
+}
+
+// the reader wakes up on the quit event itself
+void cancelConsoleInput(void)
+{
+}
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <atomic>
+#include <string>
+
+// waitable event used by the handler threads
+// Win32 builds wrap an event object (it can be waited for together with I/O handles), other systems an eventfd descriptor
+class Event
+{
+public:
+#ifdef _WIN32
+    typedef void* NativeHandle;     // HANDLE of the event object
+#else
+    typedef int NativeHandle;       // eventfd descriptor
+#endif
+    Event(bool manualReset);
+    ~Event();
+    Event(Event const&) = delete;
+    Event& operator=(Event const&) = delete;
+    void set(void) { signal(handle); }
+    void reset(void);
+    NativeHandle getNativeHandle(void) const { return handle; }
+    static void signal(NativeHandle handle);    // sets the event known only by its native handle (e.g. passed to SimConnect_Open)
+    static size_t waitAny(Event* const events[], size_t numberOfEvents, std::chrono::milliseconds timeout);     // returns index of the signaled event or Timeout
+    static constexpr size_t Timeout = SIZE_MAX;
+    static constexpr size_t MaxWaitEvents = 8;
+private:
+    bool consume(void);     // takes the signal of an automatic reset event; false if another thread took it
+    NativeHandle handle;
+    bool manualReset;
+};
+
+// monotonic clock of the session timing (periods, deadlines, age of data)
+// it follows the steady clock; soak runs advance it to compress a long session into minutes
+class SessionClock
+{
+public:
+    static std::chrono::steady_clock::time_point now(void) { return std::chrono::steady_clock::now() + std::chrono::steady_clock::duration(offset.load(std::memory_order_relaxed)); }
+    static void advance(std::chrono::steady_clock::duration time) { offset.fetch_add(time.count(), std::memory_order_relaxed); }
+private:
+    static inline std::atomic<std::chrono::steady_clock::rep> offset{ 0 };
+};
+
+uint32_t getThreadId(void);         // system identifier of the calling thread
+size_t getPrivateMemorySize(void);  // memory committed by the process and not shared with other processes [kB]
+size_t getHandleCount(void);        // open handles (file descriptors) of the process
+
+// console input which can be interrupted by the quit request
+bool readConsoleLine(std::string& line, Event& quitEvent);     // false at the end of input or when the read is cancelled
+void cancelConsoleInput(void);      // aborts the read blocked in another thread
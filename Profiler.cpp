@@ -0,0 +1,113 @@
+#include "Profiler.h"
+#include "Console.h"
+#include "Platform.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+Profiler& Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+// start a new capture; events of the previous capture are discarded
+void Profiler::start(void)
+{
+    if (capturing)
+    {
+        Console::getInstance().log(LogLevel::Warning, "trace capture is already running");
+        return;
+    }
+    if (exporting)
+    {
+        Console::getInstance().log(LogLevel::Warning, "trace export is running");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& pBuffer : buffers)
+        {
+            pBuffer->writeIndex = 0;
+        }
+    }
+    startTime = std::chrono::steady_clock::now();
+    startTicks = getTicks();
+    capturing = true;
+    Console::getInstance().log(LogLevel::Info, "trace capture started");
+}
+
+// stop the capture and export it
+void Profiler::stop(void)
+{
+    if (!capturing)
+    {
+        Console::getInstance().log(LogLevel::Warning, "trace capture is not running");
+        return;
+    }
+    exporting = true;
+    capturing = false;
+    stopTicks = getTicks();
+    stopTime = std::chrono::steady_clock::now();
+    // let the zones open at the stop time finish writing
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    exportTrace(TraceFileName);
+    exporting = false;
+}
+
+void Profiler::cancel(void)
+{
+    capturing = false;
+}
+
+Profiler::ThreadBuffer* Profiler::createThreadBuffer(void)
+{
+    auto pBuffer = std::make_unique<ThreadBuffer>();
+    pBuffer->threadId = getThreadId();
+    pBuffer->events.resize(RingSize);
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::move(pBuffer));
+    return buffers.back().get();
+}
+
+// write all captured events in Chrome trace event format (complete events with microsecond time stamps)
+void Profiler::exportTrace(std::string fileName)
+{
+    std::ofstream file(fileName);
+    if (!file.is_open())
+    {
+        Console::getInstance().log(LogLevel::Error, "cannot create trace file " + fileName);
+        return;
+    }
+
+    // time stamp counter calibration over the capture time
+    double captureTime = std::chrono::duration<double, std::micro>(stopTime - startTime).count();
+    double ticksPerMicrosecond = (captureTime > 0) && (stopTicks > startTicks) ? (stopTicks - startTicks) / captureTime : 1.0;
+
+    size_t numberOfEvents = 0;
+    file << "{\"traceEvents\":[";
+    file.precision(3);
+    file << std::fixed;
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& pBuffer : buffers)
+    {
+        uint32_t writeIndex = pBuffer->writeIndex.load(std::memory_order_acquire);
+        uint32_t firstIndex = writeIndex > RingSize ? writeIndex - RingSize : 0;     // older events have been overwritten
+        for (uint32_t index = firstIndex; index < writeIndex; index++)
+        {
+            const Event& event = pBuffer->events[index % RingSize];
+            if ((event.beginTicks < startTicks) || (event.endTicks < event.beginTicks))
+            {
+                continue;
+            }
+            file << (numberOfEvents++ ? "," : "") << "\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->threadId;
+            file << ",\"ts\":" << (event.beginTicks - startTicks) / ticksPerMicrosecond;
+            file << ",\"dur\":" << (event.endTicks - event.beginTicks) / ticksPerMicrosecond << "}";
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    std::stringstream ss;
+    ss << numberOfEvents << " trace events written to " << fileName;
+    Console::getInstance().log(LogLevel::Info, ss.str());
+}
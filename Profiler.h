@@ -0,0 +1,107 @@
+#pragma once
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// profiling zones are compiled only in builds with PROFILING defined
+#ifdef PROFILING
+#define PROFILE_ZONE_NAME(line) profileZone##line
+#define PROFILE_ZONE_LINE(name, line) ProfileZone PROFILE_ZONE_NAME(line)(name)
+#define PROFILE_ZONE(name) PROFILE_ZONE_LINE(name, __LINE__)
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+// captures begin/end times of code zones in per-thread ring buffers and exports them as Chrome trace events
+class Profiler
+{
+public:
+    Profiler(Profiler const&) = delete;
+    Profiler& operator=(Profiler const&) = delete;
+    static Profiler& getInstance();
+    void start(void);       // starts a new capture
+    void stop(void);        // stops the capture and writes the trace file
+    void cancel(void);      // stops the capture without writing the trace file
+    bool isCapturing(void) const { return capturing.load(std::memory_order_relaxed); }
+    void record(const char* name, uint64_t beginTicks, uint64_t endTicks);
+    static uint64_t getTicks(void);
+private:
+    Profiler() {}
+    struct Event
+    {
+        const char* name;       // zone names are string literals
+        uint64_t beginTicks;
+        uint64_t endTicks;
+    };
+    struct ThreadBuffer     // written only by its own thread
+    {
+        uint32_t threadId;
+        std::vector<Event> events;
+        std::atomic<uint32_t> writeIndex{ 0 };      // total number of events written; the ring keeps the newest ones
+    };
+    ThreadBuffer* createThreadBuffer(void);
+    static inline thread_local ThreadBuffer* pThreadBuffer{ nullptr };     // buffer of the calling thread
+    void exportTrace(std::string fileName);
+    static const uint32_t RingSize = 65536;     // events per thread
+    const std::string TraceFileName = "trace.json";
+    std::atomic<bool> capturing{ false };
+    std::atomic<bool> exporting{ false };       // stop may run in a background task; a new capture waits for its export
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    uint64_t startTicks{ 0 };
+    uint64_t stopTicks{ 0 };
+    std::chrono::steady_clock::time_point startTime;   // for time stamp counter calibration
+    std::chrono::steady_clock::time_point stopTime;
+};
+
+// time stamp counter; steady clock ticks on processors without it
+inline uint64_t Profiler::getTicks(void)
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// store the zone event in the ring buffer of the calling thread
+// inline, so a zone costs two counter reads and a few stores
+inline void Profiler::record(const char* name, uint64_t beginTicks, uint64_t endTicks)
+{
+    ThreadBuffer* pBuffer = pThreadBuffer;
+    if (!pBuffer)
+    {
+        // the first zone of this thread
+        pBuffer = pThreadBuffer = createThreadBuffer();
+    }
+    uint32_t index = pBuffer->writeIndex.load(std::memory_order_relaxed);
+    pBuffer->events[index % RingSize] = { name, beginTicks, endTicks };
+    pBuffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+// measures the time from its construction to the end of the scope
+class ProfileZone
+{
+public:
+    ProfileZone(const char* name) : name(name), beginTicks(Profiler::getInstance().isCapturing() ? Profiler::getTicks() : 0) {}
+    ~ProfileZone()
+    {
+        if (beginTicks)
+        {
+            Profiler::getInstance().record(name, beginTicks, Profiler::getTicks());
+        }
+    }
+private:
+    const char* name;
+    uint64_t beginTicks;    // 0 when not capturing
+};
@@ -0,0 +1,202 @@
+#include "Reactor.h"
+#include "Simulator.h"
+#include "Console.h"
+#include <conio.h>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+Reactor::Reactor(USBHID* pJoystickLink, CommandServer* pCommandServer) :
+    pJoystickLink(pJoystickLink),
+    pCommandServer(pCommandServer)
+{
+    timerHandle = CreateWaitableTimer(NULL, FALSE, NULL);
+}
+
+Reactor::~Reactor()
+{
+    CloseHandle(timerHandle);
+}
+
+// reactor loop
+void Reactor::run(void)
+{
+    enum EventSource
+    {
+        QuitEvent,
+        ConsoleInput,
+        Timer,
+        SimConnectMessage,
+        SimulatorWakeup,
+        UsbWakeup,
+        RemoteCommand,
+        UsbReception,       // must be the last one - it is waited for only while the link is open
+        NumberOfEventSources
+    };
+    HANDLE handles[NumberOfEventSources];
+    handles[QuitEvent] = Console::getInstance().getQuitEvent().getNativeHandle();
+    // a redirected input (pipe or file) is not waitable as a console - it is read by its own thread
+    HANDLE inputHandle = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD consoleMode;
+    bool isConsoleInput = (GetConsoleMode(inputHandle, &consoleMode) != FALSE);
+    handles[ConsoleInput] = isConsoleInput ? inputHandle : consoleLineEvent.getNativeHandle();
+    handles[Timer] = timerHandle;
+    handles[SimConnectMessage] = Simulator::getInstance().getSimConnectEvent().getNativeHandle();
+    handles[SimulatorWakeup] = Simulator::getInstance().getWakeupEvent().getNativeHandle();
+    handles[UsbWakeup] = pJoystickLink->getWakeupEvent();
+    handles[RemoteCommand] = pCommandServer->getRequestEvent().getNativeHandle();
+    handles[UsbReception] = pJoystickLink->getReceiveEvent();
+    pCommandServer->setDeferredExecution(true);
+
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -10000LL * TimerPeriod;     // relative time in 100 ns units
+    SetWaitableTimer(timerHandle, &dueTime, TimerPeriod, NULL, NULL, FALSE);
+    Console::getInstance().log(LogLevel::Info, "running in single-threaded reactor mode");
+    std::cout << "\n>" << std::flush;
+    std::thread consoleThread;
+    if (!isConsoleInput)
+    {
+        consoleThread = std::thread(&Reactor::readConsoleLines, this);
+    }
+
+    // stay in this loop until the user requests quit
+    auto nextTimerTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(TimerPeriod);
+    while (!Console::getInstance().isQuitRequest())
+    {
+        // the reception event of a closed link stays signaled after its read has been cancelled
+        DWORD numberOfHandles = pJoystickLink->isConnectionOpen() ? NumberOfEventSources : NumberOfEventSources - 1;
+        DWORD result = WaitForMultipleObjects(numberOfHandles, handles, FALSE, INFINITE);
+        switch (result - WAIT_OBJECT_0)
+        {
+        case QuitEvent:
+            break;
+
+        case ConsoleInput:
+            if (isConsoleInput)
+            {
+                handleConsoleInput();
+            }
+            else
+            {
+                executeConsoleLines();
+            }
+            break;
+
+        case Timer:
+            // periodic work of both handlers
+            {
+                auto now = std::chrono::steady_clock::now();
+                wakeupLatency.addSample(now - nextTimerTime);
+                nextTimerTime = now + std::chrono::milliseconds(TimerPeriod);
+            }
+            pJoystickLink->service();
+            Simulator::getInstance().service();
+            break;
+
+        case SimConnectMessage:
+        case SimulatorWakeup:
+            Simulator::getInstance().service();
+            break;
+
+        case UsbReception:
+        case UsbWakeup:
+            pJoystickLink->service();
+            break;
+
+        case RemoteCommand:
+            pCommandServer->executePending();
+            break;
+
+        default:
+            Console::getInstance().log(LogLevel::Error, "reactor wait error=" + std::to_string(GetLastError()));
+            Console::getInstance().quit();
+            break;
+        }
+    }
+
+    if (consoleThread.joinable())
+    {
+        consoleThread.join();
+    }
+    CancelWaitableTimer(timerHandle);
+    Simulator::getInstance().shutdown();
+    pJoystickLink->shutdown();
+}
+
+// collect typed characters and execute the command on Enter
+void Reactor::handleConsoleInput(void)
+{
+    if (!_kbhit())
+    {
+        // console input event other than a key (mouse, focus, key release)
+        FlushConsoleInputBuffer(GetStdHandle(STD_INPUT_HANDLE));
+        return;
+    }
+
+    while (_kbhit())
+    {
+        int character = _getch();
+        if ((character == '\r') || (character == '\n'))
+        {
+            std::cout << std::endl;
+            size_t first = consoleLine.find_first_not_of(' ');
+            if (first != std::string::npos)
+            {
+                Console::getInstance().execute(consoleLine.substr(first, consoleLine.find(' ', first) - first));
+            }
+            consoleLine.clear();
+            std::cout << "\n>" << std::flush;
+        }
+        else if (character == '\b')
+        {
+            if (!consoleLine.empty())
+            {
+                consoleLine.pop_back();
+                std::cout << "\b \b" << std::flush;
+            }
+        }
+        else if ((character == 0) || (character == 0xE0))
+        {
+            // function or arrow key - skip its second code
+            _getch();
+        }
+        else
+        {
+            consoleLine += static_cast<char>(character);
+            std::cout << static_cast<char>(character) << std::flush;
+        }
+    }
+}
+
+// queue the lines of redirected input for execution in the reactor thread
+void Reactor::readConsoleLines(void)
+{
+    std::string line;
+    while (readConsoleLine(line, Console::getInstance().getQuitEvent()))
+    {
+        std::lock_guard<std::mutex> lock(consoleLineMutex);
+        consoleLines.push_back(line);
+        consoleLineEvent.set();
+    }
+    // end of input or input cancelled by quit request
+    Console::getInstance().quit();
+}
+
+// execute the queued lines of redirected input
+void Reactor::executeConsoleLines(void)
+{
+    std::deque<std::string> lines;
+    {
+        std::lock_guard<std::mutex> lock(consoleLineMutex);
+        lines.swap(consoleLines);
+    }
+    for (auto& line : lines)
+    {
+        std::string command;
+        std::istringstream(line) >> command;
+        if (!command.empty())
+        {
+            Console::getInstance().execute(command);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "USB.h"
+#include "CommandServer.h"
+#include "LatencyStats.h"
+#include <Windows.h>
+#include <string>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+// runs USB link, simulator and console handlers in a single thread
+// the handlers are called run-to-completion when their event sources are signaled
+class Reactor
+{
+public:
+    Reactor(USBHID* pJoystickLink, CommandServer* pCommandServer);
+    ~Reactor();
+    void run(void);     // runs all handlers until the user requests quit
+    LatencyStats& getWakeupLatency(void) { return wakeupLatency; }
+private:
+    void handleConsoleInput(void);      // reads console keys without blocking
+    void readConsoleLines(void);        // reads redirected input in its own thread and queues its lines
+    void executeConsoleLines(void);     // executes the queued lines
+    USBHID* pJoystickLink;
+    CommandServer* pCommandServer;      // remote commands are executed in the reactor thread
+    LatencyStats wakeupLatency;     // timer wake-up latency
+    HANDLE timerHandle;     // periodic timer for connection attempts and joystick feedback
+    static const LONG TimerPeriod = 5;      //ms
+    std::string consoleLine;    // console command being typed
+    Event consoleLineEvent{ false };    // signaled when lines of redirected input are queued
+    std::mutex consoleLineMutex;
+    std::deque<std::string> consoleLines;
+};
@@ -0,0 +1,404 @@
+#include "ReportDescriptor.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+    enum ItemType
+    {
+        MainItem = 0,
+        GlobalItem = 1,
+        LocalItem = 2
+    };
+
+    enum MainTag
+    {
+        InputTag = 0x8,
+        OutputTag = 0x9,
+        CollectionTag = 0xA,
+        FeatureTag = 0xB,
+        EndCollectionTag = 0xC
+    };
+
+    enum GlobalTag
+    {
+        UsagePageTag = 0x0,
+        LogicalMinimumTag = 0x1,
+        LogicalMaximumTag = 0x2,
+        ReportSizeTag = 0x7,
+        ReportIDTag = 0x8,
+        ReportCountTag = 0x9,
+        PushTag = 0xA,
+        PopTag = 0xB
+    };
+
+    enum LocalTag
+    {
+        UsageTag = 0x0,
+        UsageMinimumTag = 0x1,
+        UsageMaximumTag = 0x2
+    };
+
+    const uint8_t ConstantFlag = 0x01;      // padding or constant data
+    const uint8_t VariableFlag = 0x02;      // a value per element; otherwise an array of usage indexes
+    const uint8_t LongItemPrefix = 0xFE;
+
+    struct GlobalState
+    {
+        uint16_t usagePage{ 0 };
+        int32_t logicalMin{ 0 };
+        int32_t logicalMax{ 0 };
+        uint32_t unsignedLogicalMax{ 0 };
+        uint32_t reportSize{ 0 };
+        uint32_t reportCount{ 0 };
+        uint8_t reportID{ 0 };
+    };
+
+    struct LocalState
+    {
+        std::vector<uint32_t> usages;       // usage page in the upper 16 bits if given by an extended usage
+        uint32_t usageMin{ 0 };
+        uint32_t usageMax{ 0 };
+        bool hasUsageMin{ false };
+        bool hasUsageMax{ false };
+    };
+
+    // usage page of an extended usage or the current one
+    uint16_t getUsagePage(uint32_t usage, uint16_t currentPage)
+    {
+        return (usage >> 16) ? static_cast<uint16_t>(usage >> 16) : currentPage;
+    }
+}
+
+// build the field extraction plan of the input report
+void probeReportLayout(ReportLayout& layout, uint8_t reportID, size_t reportSize,
+    const std::vector<ValueCaps>& valueCaps, const std::vector<ButtonCaps>& buttonCaps, const UsageSetter& setUsage)
+{
+    layout.clear();
+    if (reportSize == 0)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> probe(reportSize);
+    auto findFirstBit = [&probe]() -> int
+    {
+        // byte 0 is the report ID
+        for (size_t bit = 8; bit < probe.size() * 8; bit++)
+        {
+            if (probe[bit / 8] & (1 << (bit % 8)))
+            {
+                return static_cast<int>(bit);
+            }
+        }
+        return -1;
+    };
+
+    // value fields (axes, sliders, hat switches)
+    for (auto const& cap : valueCaps)
+    {
+        if ((cap.reportID != reportID) || (cap.reportCount != 1) || (cap.bitSize == 0) || (cap.bitSize > 32))
+        {
+            // other reports and value arrays are not supported
+            continue;
+        }
+        for (uint32_t usage = cap.usageMin; usage <= cap.usageMax; usage++)
+        {
+            std::fill(probe.begin(), probe.end(), 0);
+            probe[0] = reportID;
+            uint32_t maxValue = static_cast<uint32_t>((1ULL << cap.bitSize) - 1);
+            if (setUsage(probe, cap.usagePage, cap.linkCollection, static_cast<uint16_t>(usage), maxValue, false))
+            {
+                int bitOffset = findFirstBit();
+                if (bitOffset >= 0)
+                {
+                    layout.addValueField({ cap.usagePage, static_cast<uint16_t>(usage), static_cast<uint16_t>(bitOffset), static_cast<uint8_t>(cap.bitSize), cap.logicalMin, cap.logicalMax });
+                }
+            }
+        }
+    }
+
+    // buttons
+    for (auto const& cap : buttonCaps)
+    {
+        if ((cap.reportID != reportID) || (cap.usagePage != ReportLayout::ButtonPage))
+        {
+            continue;
+        }
+        for (uint32_t usage = cap.usageMin; (usage <= cap.usageMax) && (usage <= 32); usage++)
+        {
+            std::fill(probe.begin(), probe.end(), 0);
+            probe[0] = reportID;
+            if (setUsage(probe, cap.usagePage, cap.linkCollection, static_cast<uint16_t>(usage), 1, true))
+            {
+                int bitOffset = findFirstBit();
+                if (bitOffset >= 0)
+                {
+                    layout.addButton(static_cast<uint16_t>(usage), static_cast<uint16_t>(bitOffset));
+                }
+            }
+        }
+    }
+}
+
+// parse the items of the report descriptor (HID 1.11 chapter 6.2.2)
+// the input reports are laid out like the system parser does it: byte 0 is the report ID
+// or an unused byte of devices without report IDs, so the fields start at bit 8
+bool ReportDescriptor::parse(const std::vector<uint8_t>& descriptor)
+{
+    valueCaps.clear();
+    buttonCaps.clear();
+    elements.clear();
+    inputReportBits.clear();
+
+    GlobalState global;
+    std::vector<GlobalState> globalStack;
+    LocalState local;
+    std::vector<uint16_t> collectionStack;      // link collections of the open collections
+    uint16_t numberOfLinkCollections = 0;
+
+    size_t index = 0;
+    while (index < descriptor.size())
+    {
+        uint8_t prefix = descriptor[index++];
+        if (prefix == LongItemPrefix)
+        {
+            // long items are reserved - skip the data
+            if (index + 2 > descriptor.size())
+            {
+                return false;
+            }
+            index += 2 + descriptor[index];
+            continue;
+        }
+        size_t dataSize = (prefix & 0x03) == 3 ? 4 : (prefix & 0x03);
+        if (index + dataSize > descriptor.size())
+        {
+            return false;
+        }
+        uint32_t data = 0;
+        for (size_t byte = 0; byte < dataSize; byte++)
+        {
+            data |= static_cast<uint32_t>(descriptor[index + byte]) << (8 * byte);
+        }
+        index += dataSize;
+        // sign extension for items with signed data
+        int32_t signedData = ((dataSize > 0) && (dataSize < 4) && (data & (1U << (8 * dataSize - 1)))) ?
+            static_cast<int32_t>(data | (~0U << (8 * dataSize))) : static_cast<int32_t>(data);
+        uint8_t tag = prefix >> 4;
+
+        switch ((prefix >> 2) & 0x03)
+        {
+        case MainItem:
+            if (tag == InputTag)
+            {
+                uint32_t& reportBits = inputReportBits.emplace(global.reportID, 8).first->second;
+                if (reportBits + static_cast<uint64_t>(global.reportSize) * global.reportCount > UINT16_MAX)
+                {
+                    // the bit offsets of the layout are 16-bit
+                    return false;
+                }
+                // a logical maximum written without its sign byte (e.g. 0xFF for 255) is unsigned
+                int32_t logicalMax = ((global.logicalMin >= 0) && (global.logicalMax < 0)) ?
+                    static_cast<int32_t>((std::min)(global.unsignedLogicalMax, static_cast<uint32_t>(INT32_MAX))) : global.logicalMax;
+                uint16_t linkCollection = collectionStack.empty() ? 0 : collectionStack.back();
+                if (!(data & ConstantFlag) && (global.reportSize > 0) && (global.reportSize <= 32))
+                {
+                    if (data & VariableFlag)
+                    {
+                        // explicit usages followed by the usage range; the last usage applies to the remaining elements
+                        std::vector<uint32_t> usages = local.usages;
+                        if (local.hasUsageMin && local.hasUsageMax)
+                        {
+                            for (uint32_t usage = local.usageMin; (usage <= local.usageMax) && (usages.size() < global.reportCount); usage++)
+                            {
+                                usages.push_back(usage);
+                            }
+                        }
+                        for (uint32_t element = 0; (element < global.reportCount) && !usages.empty(); element++)
+                        {
+                            uint32_t usage = usages[(std::min)(static_cast<size_t>(element), usages.size() - 1)];
+                            uint16_t usagePage = getUsagePage(usage, global.usagePage);
+                            uint32_t bitOffset = reportBits + element * global.reportSize;
+                            elements.push_back({ global.reportID, usagePage, linkCollection, static_cast<uint16_t>(usage), static_cast<uint16_t>(bitOffset),
+                                static_cast<uint8_t>(global.reportSize), false, 0, 0, global.logicalMin });
+                            if (global.reportSize == 1)
+                            {
+                                buttonCaps.push_back({ global.reportID, usagePage, linkCollection, static_cast<uint16_t>(usage), static_cast<uint16_t>(usage) });
+                            }
+                            else
+                            {
+                                valueCaps.push_back({ global.reportID, usagePage, linkCollection, static_cast<uint16_t>(usage), static_cast<uint16_t>(usage),
+                                    static_cast<uint16_t>(global.reportSize), 1, global.logicalMin, logicalMax });
+                            }
+                        }
+                    }
+                    else if ((local.hasUsageMin && local.hasUsageMax) || !local.usages.empty())
+                    {
+                        // array of usage indexes (e.g. buttons reported by their numbers)
+                        uint32_t usageMin = (local.hasUsageMin && local.hasUsageMax) ? local.usageMin : local.usages.front();
+                        uint32_t usageMax = (local.hasUsageMin && local.hasUsageMax) ? local.usageMax : local.usages.back();
+                        uint16_t usagePage = getUsagePage(usageMin, global.usagePage);
+                        for (uint32_t element = 0; element < global.reportCount; element++)
+                        {
+                            uint32_t bitOffset = reportBits + element * global.reportSize;
+                            elements.push_back({ global.reportID, usagePage, linkCollection, 0, static_cast<uint16_t>(bitOffset),
+                                static_cast<uint8_t>(global.reportSize), true, static_cast<uint16_t>(usageMin), static_cast<uint16_t>(usageMax), global.logicalMin });
+                        }
+                        buttonCaps.push_back({ global.reportID, usagePage, linkCollection, static_cast<uint16_t>(usageMin), static_cast<uint16_t>(usageMax) });
+                    }
+                }
+                reportBits += global.reportSize * global.reportCount;
+            }
+            else if (tag == CollectionTag)
+            {
+                // the top-level collection is link collection 0, the nested ones are numbered in their order
+                collectionStack.push_back(collectionStack.empty() ? 0 : ++numberOfLinkCollections);
+            }
+            else if (tag == EndCollectionTag)
+            {
+                if (collectionStack.empty())
+                {
+                    return false;
+                }
+                collectionStack.pop_back();
+            }
+            // output and feature reports are not needed for the input report layout
+            local = LocalState();
+            break;
+
+        case GlobalItem:
+            switch (tag)
+            {
+            case UsagePageTag:
+                global.usagePage = static_cast<uint16_t>(data);
+                break;
+            case LogicalMinimumTag:
+                global.logicalMin = signedData;
+                break;
+            case LogicalMaximumTag:
+                global.logicalMax = signedData;
+                global.unsignedLogicalMax = data;
+                break;
+            case ReportSizeTag:
+                global.reportSize = data;
+                break;
+            case ReportIDTag:
+                if ((data == 0) || (data > UINT8_MAX))
+                {
+                    return false;
+                }
+                global.reportID = static_cast<uint8_t>(data);
+                break;
+            case ReportCountTag:
+                global.reportCount = data;
+                break;
+            case PushTag:
+                globalStack.push_back(global);
+                break;
+            case PopTag:
+                if (globalStack.empty())
+                {
+                    return false;
+                }
+                global = globalStack.back();
+                globalStack.pop_back();
+                break;
+            default:
+                break;
+            }
+            break;
+
+        case LocalItem:
+            // a usage of 4 bytes carries its usage page in the upper 16 bits
+            switch (tag)
+            {
+            case UsageTag:
+                local.usages.push_back(data);
+                break;
+            case UsageMinimumTag:
+                local.usageMin = data;
+                local.hasUsageMin = true;
+                break;
+            case UsageMaximumTag:
+                local.usageMax = data;
+                local.hasUsageMax = true;
+                break;
+            default:
+                break;
+            }
+            break;
+
+        default:
+            // reserved item type
+            return false;
+        }
+    }
+
+    return collectionStack.empty();
+}
+
+size_t ReportDescriptor::getInputReportSize(uint8_t reportID) const
+{
+    auto it = inputReportBits.find(reportID);
+    return it == inputReportBits.end() ? 0 : (it->second + 7) / 8;
+}
+
+void ReportDescriptor::buildReportLayout(ReportLayout& layout, uint8_t reportID) const
+{
+    probeReportLayout(layout, reportID, getInputReportSize(reportID), valueCaps, buttonCaps,
+        [this](std::vector<uint8_t>& report, uint16_t usagePage, uint16_t linkCollection, uint16_t usage, uint32_t value, bool isButton)
+        {
+            return setUsage(report, usagePage, linkCollection, usage, value, isButton);
+        });
+}
+
+// set the usage in the report of the report ID in byte 0
+bool ReportDescriptor::setUsage(std::vector<uint8_t>& report, uint16_t usagePage, uint16_t linkCollection, uint16_t usage, uint32_t value, bool isButton) const
+{
+    if (report.empty())
+    {
+        return false;
+    }
+    for (auto const& element : elements)
+    {
+        if ((element.reportID != report[0]) || (element.usagePage != usagePage) || (element.linkCollection != linkCollection) ||
+            (static_cast<size_t>(element.bitOffset + element.bitSize) > report.size() * 8))
+        {
+            continue;
+        }
+        uint32_t raw;
+        if (element.isArray)
+        {
+            // the first free element of the array takes the index of the usage
+            if (!isButton || (usage < element.usageMin) || (usage > element.usageMax) ||
+                (ReportLayout::extract(report.data(), report.size(), element.bitOffset, element.bitSize, false) != 0))
+            {
+                continue;
+            }
+            raw = static_cast<uint32_t>(usage - element.usageMin + element.logicalMin);
+        }
+        else
+        {
+            if ((element.usage != usage) || (isButton != (element.bitSize == 1)))
+            {
+                continue;
+            }
+            raw = isButton ? 1 : value;
+        }
+        for (uint8_t bit = 0; bit < element.bitSize; bit++)
+        {
+            size_t position = element.bitOffset + bit;
+            if (raw & (1U << bit))
+            {
+                report[position / 8] |= static_cast<uint8_t>(1 << (position % 8));
+            }
+            else
+            {
+                report[position / 8] &= static_cast<uint8_t>(~(1 << (position % 8)));
+            }
+        }
+        return true;
+    }
+    return false;
+}
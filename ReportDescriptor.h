@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ReportLayout.h"
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <functional>
+
+struct ValueCaps        // value (axis, slider, hat switch) of the input report as listed by the HID parser
+{
+    uint8_t reportID;
+    uint16_t usagePage;
+    uint16_t linkCollection;
+    uint16_t usageMin;
+    uint16_t usageMax;      // equal to usageMin for a single usage
+    uint16_t bitSize;
+    uint16_t reportCount;
+    int32_t logicalMin;
+    int32_t logicalMax;
+};
+
+struct ButtonCaps       // buttons of the input report as listed by the HID parser
+{
+    uint8_t reportID;
+    uint16_t usagePage;
+    uint16_t linkCollection;
+    uint16_t usageMin;
+    uint16_t usageMax;
+};
+
+// sets the usage to the value in an empty input report (byte 0 is the report ID); a button is set regardless of the value
+// returns false if the report has no such usage
+using UsageSetter = std::function<bool(std::vector<uint8_t>& report, uint16_t usagePage, uint16_t linkCollection, uint16_t usage, uint32_t value, bool isButton)>;
+
+// build the field extraction plan of the input report from the capabilities of the device
+// the bit position of every field is found by setting its maximum value in an empty report
+void probeReportLayout(ReportLayout& layout, uint8_t reportID, size_t reportSize,
+    const std::vector<ValueCaps>& valueCaps, const std::vector<ButtonCaps>& buttonCaps, const UsageSetter& setUsage);
+
+// parser of the raw HID report descriptor of the device
+// it lists the input capabilities and sets usages in reports like the HID parser of the system,
+// so descriptors captured from devices can be fed through the discovery of the report layout
+class ReportDescriptor
+{
+public:
+    bool parse(const std::vector<uint8_t>& descriptor);     // false for a malformed descriptor
+    const std::vector<ValueCaps>& getValueCaps(void) const { return valueCaps; }
+    const std::vector<ButtonCaps>& getButtonCaps(void) const { return buttonCaps; }
+    size_t getInputReportSize(uint8_t reportID) const;      // bytes including the report ID byte (also for devices without report IDs); 0 if there is no such report
+    bool setUsage(std::vector<uint8_t>& report, uint16_t usagePage, uint16_t linkCollection, uint16_t usage, uint32_t value, bool isButton) const;
+    void buildReportLayout(ReportLayout& layout, uint8_t reportID) const;      // probes the layout of the input report like the USB link does
+private:
+    struct InputElement     // single element of an input main item
+    {
+        uint8_t reportID;
+        uint16_t usagePage;
+        uint16_t linkCollection;
+        uint16_t usage;
+        uint16_t bitOffset;     // from the beginning of the report including the report ID byte
+        uint8_t bitSize;
+        bool isArray;           // the element carries an index of usageMin..usageMax instead of a value
+        uint16_t usageMin;      // usages of an array element
+        uint16_t usageMax;
+        int32_t logicalMin;
+    };
+    std::vector<ValueCaps> valueCaps;
+    std::vector<ButtonCaps> buttonCaps;
+    std::vector<InputElement> elements;
+    std::map<uint8_t, uint32_t> inputReportBits;    // report ID to the bits of its input report
+};
@@ -0,0 +1,95 @@
+#include "ReportLayout.h"
+#include <algorithm>
+
+void ReportLayout::clear(void)
+{
+    valueFields.clear();
+    buttonBits.clear();
+}
+
+void ReportLayout::addValueField(const ReportField& field)
+{
+    if ((field.bitSize > 0) && (field.bitSize <= 32))
+    {
+        valueFields.push_back(field);
+    }
+}
+
+void ReportLayout::addButton(uint16_t buttonNumber, uint16_t bitOffset)
+{
+    if ((buttonNumber >= 1) && (buttonNumber <= 32))
+    {
+        buttonBits.push_back({ bitOffset, static_cast<uint8_t>(buttonNumber - 1) });
+    }
+}
+
+// find the value field with the given usage
+int ReportLayout::findValueField(uint16_t usagePage, uint16_t usage) const
+{
+    for (size_t index = 0; index < valueFields.size(); index++)
+    {
+        if ((valueFields[index].usagePage == usagePage) && (valueFields[index].usage == usage))
+        {
+            return static_cast<int>(index);
+        }
+    }
+    return NoField;
+}
+
+// get the field value scaled from its logical range to -1..1
+float ReportLayout::getBipolar(const uint8_t* pReport, size_t reportSize, int fieldIndex) const
+{
+    return 2.0f * getUnipolar(pReport, reportSize, fieldIndex) - 1.0f;
+}
+
+// get the field value scaled from its logical range to 0..1
+float ReportLayout::getUnipolar(const uint8_t* pReport, size_t reportSize, int fieldIndex) const
+{
+    if ((fieldIndex < 0) || (static_cast<size_t>(fieldIndex) >= valueFields.size()))
+    {
+        return 0.0f;
+    }
+    const ReportField& field = valueFields[fieldIndex];
+    if (field.logicalMax <= field.logicalMin)
+    {
+        return 0.0f;
+    }
+    int32_t value = extract(pReport, reportSize, field.bitOffset, field.bitSize, field.logicalMin < 0);
+    float position = static_cast<float>(static_cast<int64_t>(value) - field.logicalMin) / (static_cast<int64_t>(field.logicalMax) - field.logicalMin);
+    return position < 0 ? 0 : (position > 1 ? 1 : position);
+}
+
+// get all buttons of the report in a single bitfield
+uint32_t ReportLayout::getButtons(const uint8_t* pReport, size_t reportSize) const
+{
+    uint32_t buttons = 0;
+    for (auto const& button : buttonBits)
+    {
+        size_t byteOffset = button.bitOffset / 8;
+        if (byteOffset < reportSize)
+        {
+            buttons |= static_cast<uint32_t>((pReport[byteOffset] >> (button.bitOffset % 8)) & 1) << button.bitPosition;
+        }
+    }
+    return buttons;
+}
+
+size_t ReportLayout::getFieldEnd(int fieldIndex) const
+{
+    if ((fieldIndex < 0) || (static_cast<size_t>(fieldIndex) >= valueFields.size()))
+    {
+        return 0;
+    }
+    const ReportField& field = valueFields[fieldIndex];
+    return (field.bitOffset + field.bitSize + 7) / 8;
+}
+
+size_t ReportLayout::getButtonsEnd(void) const
+{
+    size_t end = 0;
+    for (auto& button : buttonBits)
+    {
+        end = (std::max)(end, static_cast<size_t>(button.bitOffset / 8 + 1));
+    }
+    return end;
+}
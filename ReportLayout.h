@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+struct ReportField      // location of a single value in the HID input report
+{
+    uint16_t usagePage;
+    uint16_t usage;
+    uint16_t bitOffset;     // from the beginning of the report including report ID byte
+    uint8_t bitSize;        // 1..32
+    int32_t logicalMin;
+    int32_t logicalMax;
+};
+
+// field extraction plan of the HID input report built from the device report descriptor
+class ReportLayout
+{
+public:
+    static const uint16_t GenericDesktopPage = 0x01;
+    static const uint16_t SimulationPage = 0x02;
+    static const uint16_t ButtonPage = 0x09;
+    static const uint16_t UsageX = 0x30;
+    static const uint16_t UsageY = 0x31;
+    static const uint16_t UsageZ = 0x32;
+    static const uint16_t UsageRz = 0x35;
+    static const uint16_t UsageSlider = 0x36;
+    static const uint16_t UsageHatSwitch = 0x39;
+    static const uint16_t UsageThrottle = 0xBB;
+    static const int NoField = -1;
+    void clear(void);
+    void addValueField(const ReportField& field);
+    void addButton(uint16_t buttonNumber, uint16_t bitOffset);     // buttons 1..32 are mapped to bits 0..31
+    int findValueField(uint16_t usagePage, uint16_t usage) const;   // returns index of the field or NoField
+    size_t getNumberOfValueFields(void) const { return valueFields.size(); }
+    const ReportField& getValueField(size_t index) const { return valueFields[index]; }
+    float getBipolar(const uint8_t* pReport, size_t reportSize, int fieldIndex) const;      // logical range mapped to -1..1
+    float getUnipolar(const uint8_t* pReport, size_t reportSize, int fieldIndex) const;     // logical range mapped to 0..1
+    uint32_t getButtons(const uint8_t* pReport, size_t reportSize) const;      // all buttons packed into a bitfield
+    size_t getFieldEnd(int fieldIndex) const;      // report size needed for the value field; 0 for NoField
+    size_t getButtonsEnd(void) const;       // report size needed for all buttons; 0 without buttons
+    static int32_t extract(const uint8_t* pReport, size_t reportSize, uint16_t bitOffset, uint8_t bitSize, bool isSigned);
+private:
+    struct ButtonBit
+    {
+        uint16_t bitOffset;
+        uint8_t bitPosition;    // position in the buttons bitfield
+    };
+    std::vector<ReportField> valueFields;
+    std::vector<ButtonBit> buttonBits;
+};
+
+// extract the bit field from the report
+// up to 8 bytes are read with a single load, so any field up to 32 bits at any bit offset needs one shift and one mask
+inline int32_t ReportLayout::extract(const uint8_t* pReport, size_t reportSize, uint16_t bitOffset, uint8_t bitSize, bool isSigned)
+{
+    size_t byteOffset = bitOffset / 8;
+    uint64_t word = 0;
+    if (byteOffset < reportSize)
+    {
+        size_t count = reportSize - byteOffset;
+        memcpy(&word, pReport + byteOffset, count < sizeof(word) ? count : sizeof(word));   // little endian
+    }
+    uint64_t mask = (1ULL << bitSize) - 1;
+    uint32_t raw = static_cast<uint32_t>((word >> (bitOffset % 8)) & mask);
+    if (isSigned && (bitSize < 32) && (raw & (1U << (bitSize - 1))))
+    {
+        // sign extension
+        raw |= ~static_cast<uint32_t>(mask);
+    }
+    return static_cast<int32_t>(raw);
+}
@@ -1,8 +1,14 @@
 #include "Simulator.h"
 #include "Console.h"
 #include "Convert.h"
+#include "FaultInjector.h"
+#include "Profiler.h"
+#include "HealthMonitor.h"
 #include <thread>
 #include <sstream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 
 Simulator& Simulator::getInstance()
 {
@@ -13,9 +19,24 @@ Simulator& Simulator::getInstance()
 Simulator::Simulator()
 {
     Console::getInstance().log(LogLevel::Debug, "Simulator object created");
-    lastSimDataTime = lastJoystickDataTime = lastJoystickSendTime = std::chrono::steady_clock::now();
+    lastSimDataTime = lastJoystickDataTime = lastJoystickSendTime = SessionClock::now();
+    axisCurves.loadFromFile(AxisCurvesFileName);
     Console::getInstance().registerCommand("simdata", "display last simulator data", std::bind(&Simulator::displaySimData, this));
     Console::getInstance().registerCommand("joydata", "display last joystick data", std::bind(&Simulator::displayReceivedJoystickData, this));
+    Console::getInstance().registerCommand("simrestart", "reconnect SimConnect server", std::bind(&Simulator::requestRestart, this), true);
+    Console::getInstance().registerCommand("traffic", "display AI and multiplayer traffic", std::bind(&Simulator::displayTraffic, this));
+    Console::getInstance().registerCommand("writestats", "display statistics of data written to simulator", std::bind(&Simulator::displayWriteStatistics, this));
+    Console::getInstance().registerCommand("dispatchstats", "display statistics of SimConnect dispatching", std::bind(&Simulator::displayDispatchStatistics, this));
+    Console::getInstance().registerCommand("watchdog", "display state of data stream watchdog", std::bind(&Watchdog::display, &watchdog));
+    Console::getInstance().registerCommand("curves", "reload axis response curves from " + AxisCurvesFileName, std::bind(&Simulator::loadAxisCurves, this));
+    // the set is bounded by MaxUnknownIDs; new unknown IDs appearing after the warm-up mean a corrupted message stream
+    HealthMonitor::getInstance().addGauge("unknown dwIDs", [this]() { return dwIDs.size(); }, MaxUnknownIDs / 8);
+    HealthMonitor::getInstance().addGauge("traffic objects", [this]() { return trafficTable.size(); }, 1000);
+    HealthMonitor::getInstance().addGauge("aircraft profiles", [this]() { return profileCache.size(); }, 100);
+    Console::getInstance().registerQuery("simdata", std::bind(&Simulator::getSimDataJson, this));
+    Console::getInstance().registerQuery("joydata", std::bind(&Simulator::getJoystickDataJson, this));
+    Console::getInstance().registerQuery("writestats", std::bind(&Simulator::getWriteStatisticsJson, this));
+    Console::getInstance().registerQuery("traffic", std::bind(&Simulator::getTrafficJson, this));
 }
 
 Simulator::~Simulator()
@@ -25,19 +46,60 @@ Simulator::~Simulator()
 // simulator handler function
 void Simulator::handler(void)
 {
+    while (!Console::getInstance().isQuitRequest())
+    {
+        service();
+        waitForService();
+    }
+
+    shutdown();
+}
+
+// wait until the next loop, wake-up or quit request
+// in event driven mode SimConnect messages wake up the handler immediately
+void Simulator::waitForService(void)
+{
+    Event* events[] = { &Console::getInstance().getQuitEvent(), &wakeupEvent, &simConnectEvent };
+    size_t numberOfEvents = (eventDrivenDispatch && hSimConnect) ? 3 : 2;
+    auto waitStartTime = std::chrono::steady_clock::now();
+    if (Event::waitAny(events, numberOfEvents, threadSleepTime) == Event::Timeout)
+    {
+        wakeupLatency.addSample(std::chrono::steady_clock::now() - waitStartTime - threadSleepTime);
+    }
+}
+
+// service the simulator connection and the joystick feedback without waiting
+// to be called when any of the simulator events is signaled or periodically
+void Simulator::service(void)
+{
+    PROFILE_ZONE("Simulator::service");
     HRESULT hResult;
 
-    while (!Console::getInstance().isQuitRequest())
+    if (restartRequest.exchange(false) && hSimConnect)
     {
-        // manage connection to simulator
-        if (hSimConnect == nullptr)
+        // the connection will be opened again below
+        closeConnection();
+    }
+
+    if (FAULT_ACTIVE(SimDisconnect) && hSimConnect)
+    {
+        // the server closes the connection; it cannot be opened until the fault ends
+        closeConnection();
+    }
+
+    // manage connection to simulator
+    if (hSimConnect == nullptr)
+    {
+        if ((SessionClock::now() - lastConnectionAttemptTime >= ConnectionRetryPeriod) &&
+            !FAULT_ACTIVE(SimDisconnect))
         {
             // not connected to simulator - try to connect
-            hResult = SimConnect_Open(&hSimConnect, "MsSimConnect", nullptr, 0, 0, 0);
+            lastConnectionAttemptTime = SessionClock::now();
+            hResult = SimConnect_Open(&hSimConnect, "MsSimConnect", nullptr, 0, simConnectEvent.getNativeHandle(), 0);
             if (hResult == S_OK)
             {
                 Console::getInstance().log(LogLevel::Info, "connecting to SimConnect server");
-                threadSleepTime = std::chrono::milliseconds(NormalSleep);
+                threadSleepTime = eventDrivenDispatch ? JoystickSendPeriod : std::chrono::milliseconds(NormalSleep);
                 simConnectResponseError = false;
             }
             else
@@ -49,58 +111,178 @@ void Simulator::handler(void)
                 }
             }
         }
-        else
+    }
+    else
+    {
+        // connected to simulator - dispatch
+        if (!FAULT_ACTIVE(SimStall))
         {
-            // connected to simulator - dispatch
+            dispatchCallCount++;
             SimConnect_CallDispatch(hSimConnect, &Simulator::dispatchWrapper, nullptr);
         }
 
-        //send data to joystick
-        if (pJoystickLink &&
-            (std::chrono::duration<double>(std::chrono::steady_clock::now() - lastJoystickSendTime).count() > 0.02))
+        if (hSimConnect && trafficEnabled)
         {
-            uint8_t* pBuffer = joySendBuffer;
-            placeData<uint8_t>(static_cast<uint8_t>(simDataRead.flapsNumHandlePositions), pBuffer);
-            placeData<uint8_t>(static_cast<uint8_t>(simDataRead.flapsHandleIndex), pBuffer);
-            placeData<float>(static_cast<float>(simDataRead.aileronPosition - simDataRead.yokeXindicator), pBuffer);
-            placeData<uint32_t>(simDataFlags, pBuffer);
-            placeData<float>(static_cast<float>(simDataRead.throttleLever1Pos), pBuffer);
-            placeData<char>('S', pBuffer);
-            placeData<char>('I', pBuffer);
-            placeData<char>('M', pBuffer);
-            pJoystickLink->sendData(joySendBuffer);
-            lastJoystickSendTime = std::chrono::steady_clock::now();
+            if (trafficRequestPending &&
+                (SessionClock::now() - lastTrafficRequestTime > TrafficReplyTimeout))
+            {
+                // the last reply of the sweep has been lost - start a new sweep
+                trafficRequestPending = false;
+                trafficTimeoutCount++;
+                Console::getInstance().log(LogLevel::Warning, "traffic data reply timeout");
+            }
+
+            // request next traffic sweep when the previous one is complete
+            if (!trafficRequestPending &&
+                (SessionClock::now() - lastTrafficRequestTime > TrafficRequestPeriod))
+            {
+                requestTrafficData();
+            }
         }
+    }
 
-        std::this_thread::sleep_for(threadSleepTime);
+    HealthMonitor::getInstance().service();
+
+    // stale data streams are switched to the safe state before the next joystick frame
+    if (pJoystickLink && !pJoystickLink->isConnectionOpen())
+    {
+        // the device was unplugged or its link failed
+        watchdog.expire(Watchdog::JoystickData);
+    }
+    uint32_t watchdogChanges = watchdog.check();
+    if (watchdogChanges)
+    {
+        applyWatchdogState(watchdogChanges);
     }
 
-    if (hSimConnect)
+    //send data to joystick
+    if (pJoystickLink &&
+        (SessionClock::now() - lastJoystickSendTime >= JoystickSendPeriod))
     {
-        // request closing connection with server
-        hResult = SimConnect_Close(hSimConnect);
-        if (hResult == S_OK)
-        {
-            Console::getInstance().log(LogLevel::Info, "connection to Simconnect server closed");
-        }
-        else
+        // without valid simulator data the joystick gets no forces
+        bool isSimDataValid = !watchdog.isExpired(Watchdog::SimData);
+        const AircraftProfile* pProfile = pAircraftProfile;
+        FeedbackData feedbackData
         {
-            Console::getInstance().log(LogLevel::Error, "failed to disconnect from Simconnect server");
-        }
+            static_cast<uint8_t>(pProfile ? pProfile->getParameters().flapsNumHandlePositions : 0),
+            static_cast<uint8_t>(lround(simDataRead.flapsHandleIndex)),
+            isSimDataValid ? simDataRead.aileronPosition - simDataRead.yokeXindicator : 0.0,
+            isSimDataValid ? simDataFlags : simDataFlags & ~1u,
+            simDataRead.throttleLever1Pos,
+            isSimDataValid ? forceGain : 0.0f,
+            flapsLeverPosition
+        };
+        packFeedback(feedbackData, joySendBuffer);
+        pJoystickLink->sendData(joySendBuffer);
+        lastJoystickSendTime = SessionClock::now();
+    }
+
+    updateSimDataSnapshot();
+}
+
+// place the feedback data in the joystick frame
+size_t Simulator::packFeedback(const FeedbackData& data, uint8_t* pBuffer)
+{
+    uint8_t* pStart = pBuffer;
+    placeData<uint8_t>(data.flapsNumHandlePositions, pBuffer);
+    placeData<uint8_t>(data.flapsHandleIndex, pBuffer);
+    placeFixed<double>(data.yokeForce, YokeForceFormat, pBuffer);
+    placeData<uint32_t>(data.simDataFlags, pBuffer);
+    placeFixed<double>(data.throttleLeverPosition, ThrottleLeverFormat, pBuffer);
+    placeData<char>('S', pBuffer);
+    placeData<char>('I', pBuffer);
+    placeData<char>('M', pBuffer);
+    placeData<uint8_t>(FeedbackFormatVersion, pBuffer);
+    // extension fields after the marker and the version
+    placeFixed<float>(data.forceGain, ForceGainFormat, pBuffer);
+    placeFixed<float>(data.flapsLeverPosition, FlapsLeverFormat, pBuffer);
+    return static_cast<size_t>(pBuffer - pStart);
+}
+
+// apply the safe state of the streams which have just expired
+void Simulator::applyWatchdogState(uint32_t changes)
+{
+    if ((changes & (1u << Watchdog::SimData)) && watchdog.isExpired(Watchdog::SimData))
+    {
+        // simulator froze or stopped sending - joystick frames carry no forces and invalid data flag
+        setSimdataFlag(0, false);    //SimConnect data invalid
+        FAULT_DETECTED(Simulator);
+    }
+    if ((changes & (1u << Watchdog::JoystickData)) && watchdog.isExpired(Watchdog::JoystickData))
+    {
+        // joystick link lost or reports stopped - center the yoke once and stop overriding it
+        SimDataWriteGen safeData = simDataWriteGen;
+        safeData.yokeXposition = 0;
+        simDataWriteGenCoalescer.update(safeData, true);
+        FAULT_DETECTED(Joystick);
     }
 }
 
+// close the simulator connection on exit
+void Simulator::shutdown(void)
+{
+    if (hSimConnect)
+    {
+        closeConnection();
+    }
+}
+
+// use the new joystick link; its report fields are found again on the first report
+void Simulator::setJoystickLink(JoystickLink* pLink)
+{
+    pJoystickLink = pLink;
+    reportLayoutVersion = 0;
+    yokeXField = ReportLayout::NoField;
+    throttleField = ReportLayout::NoField;
+    reportMinimumSize = 0;
+}
+
+// request closing and reopening the connection from any thread
+void Simulator::requestRestart(void)
+{
+    restartRequest = true;
+    wakeupEvent.set();
+}
+
+// close connection to SimConnect server
+void Simulator::closeConnection(void)
+{
+    // request closing connection with server
+    FAULT_DETECTED(Simulator);
+    HRESULT hResult = SimConnect_Close(hSimConnect);
+    if (hResult == S_OK)
+    {
+        Console::getInstance().log(LogLevel::Info, "connection to Simconnect server closed");
+    }
+    else
+    {
+        Console::getInstance().log(LogLevel::Error, "failed to disconnect from Simconnect server");
+    }
+    hSimConnect = nullptr;
+    setSimdataFlag(0, false);    //SimConnect data invalid
+    trafficTable.clear();
+    trafficRequestPending = false;
+    threadSleepTime = std::chrono::milliseconds(LongSleep);
+}
+
 void Simulator::dispatchWrapper(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext)
 {
     Simulator::getInstance().dispatch(pData, cbData, pContext);
 }
 
 // dispatch data from simulator
-void Simulator::dispatch(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext)
+void Simulator::dispatch(SIMCONNECT_RECV* pData, [[maybe_unused]] DWORD cbData, [[maybe_unused]] void* pContext)
 {
+    PROFILE_ZONE("Simulator::dispatch");
     std::stringstream ss;
+    if (FAULT_ACTIVE(SimDropMessage))
+    {
+        return;
+    }
+    dispatchedMessageCount++;
+    DWORD dwID = FAULT_ACTIVE(SimGarbageID) ? GarbageIDBase + dispatchedMessageCount % GarbageIDRange : pData->dwID;
     // check SimConnect message ID
-    switch (pData->dwID)
+    switch (dwID)
     {
     case SIMCONNECT_RECV_ID_OPEN:
         // connection process is complete
@@ -111,14 +293,19 @@ void Simulator::dispatch(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext)
 
             subscribe();
             dataRequest();
+            simDataWriteGenCoalescer.invalidate();
+            simDataWriteThrCoalescer.invalidate();
         }
         break;
 
     case SIMCONNECT_RECV_ID_QUIT:
         // connection closed
         Console::getInstance().log(LogLevel::Info, "SimConnect server connection closed");
+        FAULT_DETECTED(Simulator);
         hSimConnect = nullptr;
         setSimdataFlag(0, false);    //SimConnect data invalid
+        trafficTable.clear();
+        trafficRequestPending = false;
         threadSleepTime = std::chrono::milliseconds(LongSleep);
         break;
 
@@ -126,21 +313,33 @@ void Simulator::dispatch(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext)
         // sim data received
         procesSimData(pData);
         setSimdataFlag(0, true);    //SimConnect data valid
-        threadSleepTime = std::chrono::milliseconds(ShortSleep);
+        FAULT_RECOVERED(Simulator);
+        if (!eventDrivenDispatch)
+        {
+            threadSleepTime = std::chrono::milliseconds(ShortSleep);
+        }
+        break;
+
+    case SIMCONNECT_RECV_ID_SIMOBJECT_DATA_BYTYPE:
+        // traffic data received
+        procesTrafficData(pData);
         break;
 
     case SIMCONNECT_RECV_ID_NULL:
         // no more data
-        threadSleepTime = std::chrono::milliseconds(NormalSleep);
+        if (!eventDrivenDispatch)
+        {
+            threadSleepTime = std::chrono::milliseconds(NormalSleep);
+        }
         break;
 
     default:
-        if (dwIDs.find(pData->dwID) != dwIDs.end())
+        if ((dwIDs.find(dwID) == dwIDs.end()) && (dwIDs.size() < MaxUnknownIDs))
         {
             // a new unknown dwID received
-            ss << "unknown dwID=" << pData->dwID << " received";
+            ss << "unknown dwID=" << dwID << " received";
             Console::getInstance().log(LogLevel::Debug, ss.str());
-            dwIDs.insert(pData->dwID);
+            dwIDs.insert(dwID);
         }
         break;
     }
@@ -154,15 +353,12 @@ void Simulator::subscribe(void)
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "YOKE X INDICATOR", "Position");    // used for yoke X zero position calculations (w/o vibrations)
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "Elevator Trim PCT", "Percent Over 100");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "Rudder Trim PCT", "Percent Over 100");
-    addToDataDefinition(hSimConnect, SimDataReadDefinition, "NUMBER OF ENGINES", "Number");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "PROP MAX RPM PERCENT:1", "Percent");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "PROP MAX RPM PERCENT:2", "Percent");
-    addToDataDefinition(hSimConnect, SimDataReadDefinition, "ESTIMATED CRUISE SPEED", "Knots");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "AIRSPEED INDICATED", "Knots");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "ROTATION VELOCITY BODY X", "Radians per second");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "ROTATION VELOCITY BODY Y", "Radians per second");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "ROTATION VELOCITY BODY Z", "Radians per second");
-    addToDataDefinition(hSimConnect, SimDataReadDefinition, "FLAPS NUM HANDLE POSITIONS", "Number");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "FLAPS HANDLE INDEX", "Number");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "AUTOPILOT MASTER", "Bool");        // autopilot master on/off
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "GENERAL ENG THROTTLE LEVER POSITION:1", "Number");
@@ -170,6 +366,12 @@ void Simulator::subscribe(void)
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "GENERAL ENG THROTTLE LEVER POSITION:3", "Number");
     addToDataDefinition(hSimConnect, SimDataReadDefinition, "GENERAL ENG THROTTLE LEVER POSITION:4", "Number");
 
+    // aircraft parameters sent only on change
+    addToDataDefinition(hSimConnect, SimDataAircraftDefinition, "TITLE", "", SIMCONNECT_DATATYPE_STRING256);
+    addToDataDefinition(hSimConnect, SimDataAircraftDefinition, "NUMBER OF ENGINES", "Number");
+    addToDataDefinition(hSimConnect, SimDataAircraftDefinition, "FLAPS NUM HANDLE POSITIONS", "Number");
+    addToDataDefinition(hSimConnect, SimDataAircraftDefinition, "ESTIMATED CRUISE SPEED", "Knots");
+
     // simconnect variables for testing
     addToDataDefinition(hSimConnect, SimDataTestDefinition, "YOKE Y POSITION", "Position");
     addToDataDefinition(hSimConnect, SimDataTestDefinition, "YOKE Y POSITION WITH AP", "Position");
@@ -188,6 +390,17 @@ void Simulator::subscribe(void)
     addToDataDefinition(hSimConnect, SimDataSetThrottleDefinition, "GENERAL ENG THROTTLE LEVER POSITION:2", "Number");   // throttle lever 2 position
     addToDataDefinition(hSimConnect, SimDataSetThrottleDefinition, "GENERAL ENG THROTTLE LEVER POSITION:3", "Number");   // throttle lever 3 position
     addToDataDefinition(hSimConnect, SimDataSetThrottleDefinition, "GENERAL ENG THROTTLE LEVER POSITION:4", "Number");   // throttle lever 4 position
+
+    // AI and multiplayer objects
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "PLANE LATITUDE", "Degrees");
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "PLANE LONGITUDE", "Degrees");
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "PLANE ALTITUDE", "Feet");
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "PLANE HEADING DEGREES TRUE", "Degrees");
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "GROUND VELOCITY", "Knots");
+    addToDataDefinition(hSimConnect, SimDataTrafficDefinition, "VERTICAL SPEED", "Feet per minute");
+
+    // simulator events triggered by joystick inputs
+    mapClientEvents();
 };
 
 // add data definition for reception from SimConnect server
@@ -208,18 +421,45 @@ void Simulator::addToDataDefinition(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITI
     }
 }
 
+// map client events to simulator events and build the joystick input table
+void Simulator::mapClientEvents(void)
+{
+    // the table is built here and swapped in at once while the joystick thread keeps processing inputs
+    std::vector<EventMapper::Mapping> mappings;
+    for (uint32_t eventID = 0; eventID < clientEventMappings.size(); eventID++)
+    {
+        const ClientEventMapping& mapping = clientEventMappings[eventID];
+        HRESULT hr = SimConnect_MapClientEventToSimEvent(hSimConnect, eventID, mapping.simEventName);
+        if (hr == S_OK)
+        {
+            mappings.push_back({ mapping.bitPosition, mapping.trigger, eventID });
+            std::string text("mapped event: ");
+            text += mapping.simEventName;
+            Console::getInstance().log(LogLevel::Debug, text);
+        }
+        else
+        {
+            std::string text("failed to map event: ");
+            text += mapping.simEventName;
+            Console::getInstance().log(LogLevel::Error, text);
+        }
+    }
+    eventMapper.setMappings(mappings);
+}
+
 // request all subscribed data from SimConnect server
 void Simulator::dataRequest(void)
 {
     requestDataOnSimObject(SimDataReadRequest, SimDataReadDefinition, SIMCONNECT_PERIOD_SIM_FRAME);
     requestDataOnSimObject(SimDataTestRequest, SimDataTestDefinition, SIMCONNECT_PERIOD_SECOND);
+    requestDataOnSimObject(SimDataAircraftRequest, SimDataAircraftDefinition, SIMCONNECT_PERIOD_SECOND, SIMCONNECT_DATA_REQUEST_FLAG_CHANGED);
 }
 
 // request data from SimConnect server - called from Simulator::dataRequest
-void Simulator::requestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_PERIOD Period)
+void Simulator::requestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_PERIOD Period, SIMCONNECT_DATA_REQUEST_FLAG Flags)
 {
     std::stringstream ss;
-    HRESULT hr = SimConnect_RequestDataOnSimObject(hSimConnect, RequestID, DefineID, SIMCONNECT_OBJECT_ID_USER, Period);
+    HRESULT hr = SimConnect_RequestDataOnSimObject(hSimConnect, RequestID, DefineID, SIMCONNECT_OBJECT_ID_USER, Period, Flags);
     if (hr == S_OK)
     {
         ss << "request data: def=" << DefineID << ", req=" << RequestID << ", period=" << Period;
@@ -232,20 +472,64 @@ void Simulator::requestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID RequestID, SIM
     }
 }
 
+// request data of all aircraft within the traffic radius
+// SimConnect sends one message per object; the sweep ends with the last of them
+void Simulator::requestTrafficData(void)
+{
+    lastTrafficRequestTime = SessionClock::now();
+    HRESULT hr = SimConnect_RequestDataOnSimObjectType(hSimConnect, SimDataTrafficRequest, SimDataTrafficDefinition, TrafficRadius, SIMCONNECT_SIMOBJECT_TYPE_AIRCRAFT);
+    if (hr == S_OK)
+    {
+        trafficRequestPending = true;
+    }
+    else
+    {
+        std::stringstream ss;
+        ss << "traffic data request error: def=" << SimDataTrafficDefinition << ", req=" << SimDataTrafficRequest;
+        Console::getInstance().log(LogLevel::Error, ss.str());
+    }
+}
+
+// process traffic data received from simulator
+void Simulator::procesTrafficData(SIMCONNECT_RECV* pData)
+{
+    SIMCONNECT_RECV_SIMOBJECT_DATA_BYTYPE* pObjData = static_cast<SIMCONNECT_RECV_SIMOBJECT_DATA_BYTYPE*>(pData);
+    if (pObjData->dwRequestID != SimDataTrafficRequest)
+    {
+        return;
+    }
+
+    if (pObjData->dwoutof > 0)
+    {
+        SimDataTraffic* pSimDataTraffic = reinterpret_cast<SimDataTraffic*>(&pObjData->dwData);
+        trafficTable.update({ static_cast<uint32_t>(pObjData->dwObjectID), pSimDataTraffic->latitude, pSimDataTraffic->longitude, pSimDataTraffic->altitude,
+            pSimDataTraffic->heading, pSimDataTraffic->groundSpeed, pSimDataTraffic->verticalSpeed });
+    }
+
+    if (pObjData->dwentrynumber >= pObjData->dwoutof)
+    {
+        // the last object of this sweep
+        trafficTable.endSweep();
+        trafficRequestPending = false;
+    }
+}
+
 // process data received from simulator
 void Simulator::procesSimData(SIMCONNECT_RECV* pData)
 {
+    PROFILE_ZONE("Simulator::procesSimData");
     SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = static_cast<SIMCONNECT_RECV_SIMOBJECT_DATA*>(pData);
     std::stringstream ss;
     switch (pObjData->dwRequestID)
     {
     case SimDataReadRequest:
         {
-            auto simDataTime = std::chrono::steady_clock::now();
+            auto simDataTime = SessionClock::now();
             SimDataRead* pSimDataRead = reinterpret_cast<SimDataRead*>(&pObjData->dwData);
             memcpy(&simDataRead, pSimDataRead, sizeof(SimDataRead));
             simDataInterval = std::chrono::duration<double>(simDataTime - lastSimDataTime).count();
             lastSimDataTime = simDataTime;
+            watchdog.feed(Watchdog::SimData);
 
             setSimdataFlag(1, simDataRead.autopilotMaster != 0);    //flag of autopilot master on/off
 
@@ -255,13 +539,35 @@ void Simulator::procesSimData(SIMCONNECT_RECV* pData)
             lastRotationVelocityBodyX = simDataRead.rotationVelocityBodyX;
             lastRotationVelocityBodyY = simDataRead.rotationVelocityBodyY;
             lastRotationVelocityBodyZ = simDataRead.rotationVelocityBodyZ;
+
+            // aircraft specific scaling from precomputed tables
+            const AircraftProfile* pProfile = pAircraftProfile;
+            if (pProfile)
+            {
+                forceGain = pProfile->getForceGain(simDataRead.indicatedAirspeed);
+                flapsLeverPosition = pProfile->getFlapsLeverPosition(simDataRead.flapsHandleIndex);
+            }
+
+            // the only data of every simulator frame; replies of the 1 Hz requests do not flush
+            flushSimData();     // one write per data definition per simulator frame
+        }
+        break;
+
+    case SimDataAircraftRequest:
+        // aircraft changed
+        {
+            SimDataAircraft* pSimDataAircraft = reinterpret_cast<SimDataAircraft*>(&pObjData->dwData);
+            aircraftTitle = std::string(pSimDataAircraft->title, strnlen(pSimDataAircraft->title, sizeof(pSimDataAircraft->title)));
+            const AircraftProfile* pProfile = profileCache.getProfile(aircraftTitle, pSimDataAircraft->parameters);
+            axisCurves.setProfileCurve(AxisCurves::YokeX, pProfile->getYokeXCurve());
+            pAircraftProfile = pProfile;
         }
         break;
 
     case SimDataTestRequest:
         // XXX print parameters for test
         {
-            SimDataTest* pVariableCheck = reinterpret_cast<SimDataTest*>(&pObjData->dwData);
+            [[maybe_unused]] SimDataTest* pVariableCheck = reinterpret_cast<SimDataTest*>(&pObjData->dwData);
             //ss << "yYp=" << pVariableCheck->yokeYposition << "  ";
             //ss << "yYpAP=" << pVariableCheck->yokeYpositionAP << "  ";
             //ss << "yYi=" << pVariableCheck->yokeYindicator << "  ";
@@ -288,10 +594,63 @@ void Simulator::procesSimData(SIMCONNECT_RECV* pData)
 // parse received data from joystick link
 void Simulator::parseReceivedData(std::vector<uint8_t> receivedData)
 {
-    lastJoystickDataTime = std::chrono::steady_clock::now();
-    uint8_t* pData = &receivedData.data()[1];
-    joyData.yokeXposition = parseData<float>(pData);
-    joyData.commandedThrottle = parseData<float>(pData);
+    PROFILE_ZONE("Simulator::parseReceivedData");
+    const ReportLayout* pLayout = pJoystickLink ? &pJoystickLink->getReportLayout() : nullptr;
+    if (pLayout && (pJoystickLink->getReportLayoutVersion() != reportLayoutVersion))
+    {
+        // new device layout - find the fields once instead of on every report
+        reportLayoutVersion = pJoystickLink->getReportLayoutVersion();
+        yokeXField = pLayout->findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageX);
+        throttleField = pLayout->findValueField(ReportLayout::SimulationPage, ReportLayout::UsageThrottle);
+        if (throttleField == ReportLayout::NoField)
+        {
+            throttleField = pLayout->findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageSlider);
+        }
+        if (throttleField == ReportLayout::NoField)
+        {
+            throttleField = pLayout->findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageZ);
+        }
+        // fields beyond the end of a truncated report would read as 0, e.g. an idle throttle command
+        reportMinimumSize = (std::max)({ pLayout->getFieldEnd(yokeXField), pLayout->getFieldEnd(throttleField), pLayout->getButtonsEnd() });
+    }
+
+    // a descriptor based report must contain the yoke X field and all other fields of the layout used here; the vendor report must contain both axes
+    bool isVendorReport = !pLayout || (yokeXField == ReportLayout::NoField);
+    size_t minimumSize = isVendorReport ? VendorReport::ButtonsOffset : reportMinimumSize;
+    if (receivedData.size() < minimumSize)
+    {
+        // truncated report
+        malformedReportCount++;
+        FAULT_DETECTED(Joystick);
+        return;
+    }
+    lastJoystickDataTime = SessionClock::now();
+    watchdog.feed(Watchdog::JoystickData);
+    FAULT_RECOVERED(Joystick);
+
+    if (!isVendorReport)
+    {
+        // fields discovered from the report descriptor
+        joyData.yokeXposition = pLayout->getBipolar(receivedData.data(), receivedData.size(), yokeXField);
+        joyData.commandedThrottle = pLayout->getUnipolar(receivedData.data(), receivedData.size(), throttleField);
+        joyData.buttons = pLayout->getButtons(receivedData.data(), receivedData.size());
+    }
+    else
+    {
+        // vendor defined report with fixed offsets
+        uint8_t* pData = &receivedData.data()[1];
+        joyData.yokeXposition = parseData<float>(pData);
+        joyData.commandedThrottle = parseData<float>(pData);
+        // the buttons are valid only in reports which declare their version; undefined bytes must not trigger events
+        bool hasButtons = (receivedData.size() > VendorReport::VersionOffset) && (receivedData[VendorReport::VersionOffset] >= VendorReport::ButtonsVersion);
+        joyData.buttons = hasButtons ? parseData<uint32_t>(pData) : 0;
+    }
+    eventMapper.processInputs(joyData.buttons);
+
+    // apply response curves to all axes at once; the throttle input is mapped to every engine
+    float axisInputs[AxisCurves::NumberOfAxes] = { joyData.yokeXposition, joyData.commandedThrottle, joyData.commandedThrottle, joyData.commandedThrottle, joyData.commandedThrottle };
+    float axisOutputs[AxisCurves::NumberOfAxes];
+    axisCurves.evaluate(axisInputs, axisOutputs);
 
     //prepare data for simulator
     if (simDataRead.autopilotMaster != 0)
@@ -301,73 +660,135 @@ void Simulator::parseReceivedData(std::vector<uint8_t> receivedData)
     }
     else
     {
-        // autopilot is off
-        simDataWriteGen.yokeXposition = joyData.yokeXposition;
+        // autopilot is off; the curve includes the yoke response of the aircraft profile
+        simDataWriteGen.yokeXposition = axisOutputs[AxisCurves::YokeX];
     }
 
-    std::stringstream ss;
-    HRESULT hr = SimConnect_SetDataOnSimObject(hSimConnect, SimDataWriteDefinition, SIMCONNECT_OBJECT_ID_USER, 0, 0, sizeof(SimDataWriteGen), &simDataWriteGen);
+    simDataWriteGenCoalescer.update(simDataWriteGen, !writeCoalescing);
+
+    if (throttleArbiter.setRequested(joyData.commandedThrottle, simDataRead.throttleLever1Pos, 10))
+    {
+        // request for setting throttle in simulator
+        simDataWriteThr.commandedThrottle1 = axisOutputs[AxisCurves::Throttle1];
+        simDataWriteThr.commandedThrottle2 = axisOutputs[AxisCurves::Throttle2];
+        simDataWriteThr.commandedThrottle3 = axisOutputs[AxisCurves::Throttle3];
+        simDataWriteThr.commandedThrottle4 = axisOutputs[AxisCurves::Throttle4];
+        simDataWriteThrCoalescer.update(simDataWriteThr, true);
+    }
+
+    SimDataWriteGen dataGen;
+    if (!writeCoalescing && hSimConnect && simDataWriteGenCoalescer.getDataToFlush(dataGen))
+    {
+        // the yoke position of every report is written without waiting for the simulator frame
+        setDataOnSimObject(SimDataWriteDefinition, sizeof(SimDataWriteGen), &dataGen);
+    }
+
+    updateJoystickSnapshot();
+}
+
+// write pending data to simulator - called once per simulator frame
+void Simulator::flushSimData(void)
+{
+    PROFILE_ZONE("Simulator::flushSimData");
+    flushCount++;
+    SimDataWriteGen dataGen;
+    if (simDataWriteGenCoalescer.getDataToFlush(dataGen))
+    {
+        setDataOnSimObject(SimDataWriteDefinition, sizeof(SimDataWriteGen), &dataGen);
+    }
+
+    SimDataWriteThr dataThr;
+    if (simDataWriteThrCoalescer.getDataToFlush(dataThr))
+    {
+        setDataOnSimObject(SimDataSetThrottleDefinition, sizeof(SimDataWriteThr), &dataThr);
+    }
+
+    // transmit all events triggered since the last frame
+    if (eventMapper.takePendingEvents(clientEventsToSend))
+    {
+        for (auto eventID : clientEventsToSend)
+        {
+            transmitEventCount++;
+            HRESULT hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, eventID, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+            if (hr != S_OK)
+            {
+                std::stringstream ss;
+                ss << "failed to transmit event " << clientEventMappings[eventID].simEventName;
+                Console::getInstance().log(LogLevel::Error, ss.str());
+            }
+        }
+    }
+}
+
+// set data in SimConnect server - called from Simulator::flushSimData
+void Simulator::setDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID DefineID, DWORD cbUnitSize, void* pDataSet)
+{
+    setDataCallCount++;
+    HRESULT hr = SimConnect_SetDataOnSimObject(hSimConnect, DefineID, SIMCONNECT_OBJECT_ID_USER, 0, 0, cbUnitSize, pDataSet);
     if ((hr != S_OK) && (!simConnectSetError))
     {
-        ss << "failed to set in simConnect server";
-        Console::getInstance().log(LogLevel::Error, ss.str());
+        Console::getInstance().log(LogLevel::Error, "failed to set in simConnect server");
         simConnectSetError = true;
     }
     if ((hr == S_OK) && (simConnectSetError))
     {
-        ss << "sucseeded to set in simConnect server";
-        Console::getInstance().log(LogLevel::Info, ss.str());
+        Console::getInstance().log(LogLevel::Info, "sucseeded to set in simConnect server");
         simConnectSetError = false;
     }
-
-    if (throttleArbiter.setRequested(joyData.commandedThrottle, simDataRead.throttleLever1Pos, 10))
-    {
-        // request for setting throttle in simulator
-        simDataWriteThr.commandedThrottle1 = simDataWriteThr.commandedThrottle2 = simDataWriteThr.commandedThrottle3 = simDataWriteThr.commandedThrottle4 = joyData.commandedThrottle;
-        SimConnect_SetDataOnSimObject(hSimConnect, SimDataSetThrottleDefinition, SIMCONNECT_OBJECT_ID_USER, 0, 0, sizeof(SimDataWriteThr), &simDataWriteThr);
-        putchar('.');
-    }
 }
 
 // display current data received from SimConnect server
 void Simulator::displaySimData()
 {
-    std::cout << "time from last SimData [s] = " << std::chrono::duration<double>(std::chrono::steady_clock::now() - lastSimDataTime).count() << std::endl;
-    std::cout << "last SimData interval [s] = " << simDataInterval << std::endl;
+    SimDataSnapshot simData = getSimDataSnapshot();
+    JoystickSnapshot joystick = getJoystickSnapshot();
+    std::cout << "time from last SimData [s] = " << std::chrono::duration<double>(SessionClock::now() - simData.lastSimDataTime).count() << std::endl;
+    std::cout << "last SimData interval [s] = " << simData.simDataInterval << std::endl;
+    std::cout << "========== aircraft ==========" << std::endl;
+    std::cout << "title = " << simData.aircraftTitle.c_str() << std::endl;
+    if (simData.hasProfile)
+    {
+        std::cout << "number of engines = " << simData.aircraftParameters.numberOfEngines << std::endl;
+        std::cout << "estimated cruise speed [kts] = " << simData.aircraftParameters.estimatedCruiseSpeed << std::endl;
+        std::cout << "number of flaps positions = " << simData.aircraftParameters.flapsNumHandlePositions << std::endl;
+    }
+    std::cout << "cached profiles = " << simData.cachedProfiles << std::endl;
     std::cout << "========== SimDataRead ==========" << std::endl;
-    std::cout << "aileron position = " << simDataRead.aileronPosition << std::endl;
-    std::cout << "yoke X indicator = " << simDataRead.yokeXindicator << std::endl;
-    std::cout << "elevator trim % = " << simDataRead.elevatorTrimPCT << std::endl;
-    std::cout << "rudder trim % = " << simDataRead.rudderTrimPCT << std::endl;
-    std::cout << "number of engines = " << simDataRead.numberOfEngines << std::endl;
-    std::cout << "propeller 1 % = " << simDataRead.prop1Percent << std::endl;
-    std::cout << "propeller 2 % = " << simDataRead.prop2Percent << std::endl;
-    std::cout << "estimated cruise speed [kts] = " << simDataRead.estimatedCruiseSpeed << std::endl;
-    std::cout << "indicated airspeed [kts] = " << simDataRead.indicatedAirspeed << std::endl;
-    std::cout << "rotation velocity body X [rad/s] = " << simDataRead.rotationVelocityBodyX << std::endl;
-    std::cout << "rotation velocity body Y [rad/s] = " << simDataRead.rotationVelocityBodyY << std::endl;
-    std::cout << "rotation velocity body Z [rad/s] = " << simDataRead.rotationVelocityBodyZ << std::endl;
-    std::cout << "number of flaps positions = " << simDataRead.flapsNumHandlePositions << std::endl;
-    std::cout << "flaps lever position = " << simDataRead.flapsHandleIndex << std::endl;
-    std::cout << "autopilot master = " << simDataRead.autopilotMaster << std::endl;
-    std::cout << "throttle lever = " << simDataRead.throttleLever1Pos << std::endl;
+    std::cout << "aileron position = " << simData.simDataRead.aileronPosition << std::endl;
+    std::cout << "yoke X indicator = " << simData.simDataRead.yokeXindicator << std::endl;
+    std::cout << "elevator trim % = " << simData.simDataRead.elevatorTrimPCT << std::endl;
+    std::cout << "rudder trim % = " << simData.simDataRead.rudderTrimPCT << std::endl;
+    std::cout << "propeller 1 % = " << simData.simDataRead.prop1Percent << std::endl;
+    std::cout << "propeller 2 % = " << simData.simDataRead.prop2Percent << std::endl;
+    std::cout << "indicated airspeed [kts] = " << simData.simDataRead.indicatedAirspeed << std::endl;
+    std::cout << "rotation velocity body X [rad/s] = " << simData.simDataRead.rotationVelocityBodyX << std::endl;
+    std::cout << "rotation velocity body Y [rad/s] = " << simData.simDataRead.rotationVelocityBodyY << std::endl;
+    std::cout << "rotation velocity body Z [rad/s] = " << simData.simDataRead.rotationVelocityBodyZ << std::endl;
+    std::cout << "flaps lever position = " << simData.simDataRead.flapsHandleIndex << std::endl;
+    std::cout << "autopilot master = " << simData.simDataRead.autopilotMaster << std::endl;
+    std::cout << "throttle lever = " << simData.simDataRead.throttleLever1Pos << std::endl;
     std::cout << "========== SimDataWrite ==========" << std::endl;
-    std::cout << "yoke X position = " << simDataWriteGen.yokeXposition << std::endl;
-    std::cout << "flaps handle index = " << simDataWriteGen.flapsHandleIndex << std::endl;
-    std::cout << "commanded throttle = " << simDataWriteThr.commandedThrottle1 << std::endl;
+    std::cout << "yoke X position = " << joystick.simDataWriteGen.yokeXposition << std::endl;
+    std::cout << "flaps handle index = " << joystick.simDataWriteGen.flapsHandleIndex << std::endl;
+    std::cout << "commanded throttle = " << joystick.simDataWriteThr.commandedThrottle1 << std::endl;
     std::cout << "========== calculated data ==========" << std::endl;
-    std::cout << "angular acceleration X [rad/s2] = " << angularAccelerationX << std::endl;
-    std::cout << "angular acceleration Y [rad/s2] = " << angularAccelerationX << std::endl;
-    std::cout << "angular acceleration Z [rad/s2] = " << angularAccelerationZ << std::endl;
+    std::cout << "angular acceleration X [rad/s2] = " << simData.angularAccelerationX << std::endl;
+    std::cout << "angular acceleration Y [rad/s2] = " << simData.angularAccelerationY << std::endl;
+    std::cout << "angular acceleration Z [rad/s2] = " << simData.angularAccelerationZ << std::endl;
+    std::cout << "force gain = " << simData.forceGain << std::endl;
+    std::cout << "flaps lever position = " << simData.flapsLeverPosition << std::endl;
 }
 
 // display current data received from Joystick
 void Simulator::displayReceivedJoystickData()
 {
-    std::cout << "time from last joystick reception [s] = " << std::chrono::duration<double>(std::chrono::steady_clock::now() - lastJoystickDataTime).count() << std::endl;
+    JoystickSnapshot joystick = getJoystickSnapshot();
+    std::cout << "time from last joystick reception [s] = " << std::chrono::duration<double>(SessionClock::now() - joystick.lastJoystickDataTime).count() << std::endl;
     std::cout << "========== Joystick Data ==========" << std::endl;
-    std::cout << "yoke X position = " << joyData.yokeXposition << std::endl;
-    std::cout << "commanded throttle = " << joyData.commandedThrottle << std::endl;
+    std::cout << "yoke X position = " << joystick.joyData.yokeXposition << std::endl;
+    std::cout << "commanded throttle = " << joystick.joyData.commandedThrottle << std::endl;
+    std::cout << "buttons = 0x" << std::hex << joystick.joyData.buttons << std::dec << std::endl;
+    std::cout << "malformed reports = " << malformedReportCount << std::endl;
 }
 
 //set/reset sim data flag
@@ -381,4 +802,200 @@ void Simulator::setSimdataFlag(uint8_t bitPosition, bool value)
     {
         simDataFlags &= ~(1 << bitPosition);
     }
+}
+
+// display statistics of data written to simulator
+void Simulator::displayWriteStatistics()
+{
+    std::cout << "SetData calls = " << setDataCallCount << std::endl;
+    std::cout << "flushes = " << flushCount << std::endl;
+    std::cout << "========== general data ==========" << std::endl;
+    std::cout << "updates = " << simDataWriteGenCoalescer.getUpdateCount() << std::endl;
+    std::cout << "writes = " << simDataWriteGenCoalescer.getWriteCount() << std::endl;
+    std::cout << "skipped unchanged = " << simDataWriteGenCoalescer.getUnchangedCount() << std::endl;
+    std::cout << "merged within frame = " << simDataWriteGenCoalescer.getMergedCount() << std::endl;
+    std::cout << "========== throttle data ==========" << std::endl;
+    std::cout << "updates = " << simDataWriteThrCoalescer.getUpdateCount() << std::endl;
+    std::cout << "writes = " << simDataWriteThrCoalescer.getWriteCount() << std::endl;
+    std::cout << "skipped unchanged = " << simDataWriteThrCoalescer.getUnchangedCount() << std::endl;
+    std::cout << "merged within frame = " << simDataWriteThrCoalescer.getMergedCount() << std::endl;
+    std::cout << "========== client events ==========" << std::endl;
+    std::cout << "triggered = " << eventMapper.getTriggeredCount() << std::endl;
+    std::cout << "transmitted = " << transmitEventCount << std::endl;
+}
+
+// display AI and multiplayer traffic
+void Simulator::displayTraffic()
+{
+    std::vector<TrafficObject> objects;
+    trafficTable.getSnapshot(objects);
+    std::cout << "traffic sweeps = " << (trafficEnabled ? "enabled" : "disabled") << std::endl;
+    std::cout << "number of objects = " << objects.size() << std::endl;
+    std::cout << "number of sweeps = " << trafficTable.getSweepCount() << std::endl;
+    std::cout << "reply timeouts = " << trafficTimeoutCount << std::endl;
+    for (auto const& object : objects)
+    {
+        std::cout << "id=" << object.objectID;
+        std::cout << " lat=" << object.latitude;
+        std::cout << " lon=" << object.longitude;
+        std::cout << " alt=" << object.altitude;
+        std::cout << " hdg=" << object.heading;
+        std::cout << " gs=" << object.groundSpeed;
+        std::cout << " vs=" << object.verticalSpeed << std::endl;
+    }
+}
+
+// get current data received from SimConnect server as JSON
+std::string Simulator::getSimDataJson()
+{
+    SimDataSnapshot simData = getSimDataSnapshot();
+    std::stringstream ss;
+    ss << "{\"timeFromLastSimData\":" << std::chrono::duration<double>(SessionClock::now() - simData.lastSimDataTime).count();
+    ss << ",\"simDataInterval\":" << simData.simDataInterval;
+    ss << ",\"connected\":" << (simData.isConnected ? "true" : "false");
+    ss << ",\"simDataFlags\":" << simData.simDataFlags;
+    ss << ",\"aileronPosition\":" << simData.simDataRead.aileronPosition;
+    ss << ",\"yokeXindicator\":" << simData.simDataRead.yokeXindicator;
+    ss << ",\"elevatorTrimPCT\":" << simData.simDataRead.elevatorTrimPCT;
+    ss << ",\"rudderTrimPCT\":" << simData.simDataRead.rudderTrimPCT;
+    ss << ",\"indicatedAirspeed\":" << simData.simDataRead.indicatedAirspeed;
+    ss << ",\"rotationVelocityBodyX\":" << simData.simDataRead.rotationVelocityBodyX;
+    ss << ",\"rotationVelocityBodyY\":" << simData.simDataRead.rotationVelocityBodyY;
+    ss << ",\"rotationVelocityBodyZ\":" << simData.simDataRead.rotationVelocityBodyZ;
+    ss << ",\"flapsHandleIndex\":" << simData.simDataRead.flapsHandleIndex;
+    ss << ",\"autopilotMaster\":" << simData.simDataRead.autopilotMaster;
+    ss << ",\"throttleLever1Pos\":" << simData.simDataRead.throttleLever1Pos;
+    ss << ",\"angularAccelerationX\":" << simData.angularAccelerationX;
+    ss << ",\"angularAccelerationY\":" << simData.angularAccelerationY;
+    ss << ",\"angularAccelerationZ\":" << simData.angularAccelerationZ;
+    ss << ",\"forceGain\":" << simData.forceGain;
+    ss << ",\"flapsLeverPosition\":" << simData.flapsLeverPosition << "}";
+    return ss.str();
+}
+
+// get current data received from joystick as JSON
+std::string Simulator::getJoystickDataJson()
+{
+    JoystickSnapshot joystick = getJoystickSnapshot();
+    std::stringstream ss;
+    ss << "{\"timeFromLastJoystickData\":" << std::chrono::duration<double>(SessionClock::now() - joystick.lastJoystickDataTime).count();
+    ss << ",\"yokeXposition\":" << joystick.joyData.yokeXposition;
+    ss << ",\"commandedThrottle\":" << joystick.joyData.commandedThrottle;
+    ss << ",\"buttons\":" << joystick.joyData.buttons;
+    ss << ",\"malformedReports\":" << malformedReportCount << "}";
+    return ss.str();
+}
+
+// get statistics of data written to simulator as JSON
+std::string Simulator::getWriteStatisticsJson()
+{
+    std::stringstream ss;
+    ss << "{\"setDataCalls\":" << setDataCallCount;
+    ss << ",\"general\":{\"updates\":" << simDataWriteGenCoalescer.getUpdateCount();
+    ss << ",\"writes\":" << simDataWriteGenCoalescer.getWriteCount();
+    ss << ",\"unchanged\":" << simDataWriteGenCoalescer.getUnchangedCount();
+    ss << ",\"merged\":" << simDataWriteGenCoalescer.getMergedCount() << "}";
+    ss << ",\"throttle\":{\"updates\":" << simDataWriteThrCoalescer.getUpdateCount();
+    ss << ",\"writes\":" << simDataWriteThrCoalescer.getWriteCount();
+    ss << ",\"unchanged\":" << simDataWriteThrCoalescer.getUnchangedCount();
+    ss << ",\"merged\":" << simDataWriteThrCoalescer.getMergedCount() << "}";
+    ss << ",\"events\":{\"triggered\":" << eventMapper.getTriggeredCount();
+    ss << ",\"transmitted\":" << transmitEventCount << "}}";
+    return ss.str();
+}
+
+// get AI and multiplayer traffic as JSON
+std::string Simulator::getTrafficJson()
+{
+    std::vector<TrafficObject> objects;
+    trafficTable.getSnapshot(objects);
+    std::stringstream ss;
+    ss << "{\"enabled\":" << (trafficEnabled ? "true" : "false");
+    ss << ",\"sweeps\":" << trafficTable.getSweepCount();
+    ss << ",\"timeouts\":" << trafficTimeoutCount << ",\"objects\":[";
+    for (size_t index = 0; index < objects.size(); index++)
+    {
+        ss << (index ? "," : "") << "{\"id\":" << objects[index].objectID;
+        ss << ",\"lat\":" << objects[index].latitude;
+        ss << ",\"lon\":" << objects[index].longitude;
+        ss << ",\"alt\":" << objects[index].altitude;
+        ss << ",\"hdg\":" << objects[index].heading;
+        ss << ",\"gs\":" << objects[index].groundSpeed;
+        ss << ",\"vs\":" << objects[index].verticalSpeed << "}";
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+// copy the simulator data for the console and remote clients
+void Simulator::updateSimDataSnapshot(void)
+{
+    const AircraftProfile* pProfile = pAircraftProfile;
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    simDataSnapshot.lastSimDataTime = lastSimDataTime;
+    simDataSnapshot.simDataInterval = simDataInterval;
+    simDataSnapshot.isConnected = hSimConnect != nullptr;
+    simDataSnapshot.simDataFlags = simDataFlags;
+    simDataSnapshot.simDataRead = simDataRead;
+    simDataSnapshot.angularAccelerationX = angularAccelerationX;
+    simDataSnapshot.angularAccelerationY = angularAccelerationY;
+    simDataSnapshot.angularAccelerationZ = angularAccelerationZ;
+    simDataSnapshot.forceGain = forceGain;
+    simDataSnapshot.flapsLeverPosition = flapsLeverPosition;
+    if (simDataSnapshot.aircraftTitle != aircraftTitle)
+    {
+        simDataSnapshot.aircraftTitle = aircraftTitle;
+    }
+    simDataSnapshot.hasProfile = pProfile != nullptr;
+    if (pProfile)
+    {
+        simDataSnapshot.aircraftParameters = pProfile->getParameters();
+    }
+    simDataSnapshot.cachedProfiles = profileCache.size();
+}
+
+// copy the joystick data for the console and remote clients
+void Simulator::updateJoystickSnapshot(void)
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    joystickSnapshot.lastJoystickDataTime = lastJoystickDataTime;
+    joystickSnapshot.joyData = joyData;
+    joystickSnapshot.simDataWriteGen = simDataWriteGen;
+    joystickSnapshot.simDataWriteThr = simDataWriteThr;
+}
+
+Simulator::SimDataSnapshot Simulator::getSimDataSnapshot(void)
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return simDataSnapshot;
+}
+
+Simulator::JoystickSnapshot Simulator::getJoystickSnapshot(void)
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return joystickSnapshot;
+}
+
+// display statistics of SimConnect dispatching
+void Simulator::displayDispatchStatistics()
+{
+    std::cout << "dispatch mode = " << (eventDrivenDispatch ? "event driven" : "polling") << std::endl;
+    std::cout << "dispatch calls = " << dispatchCallCount << std::endl;
+    std::cout << "dispatched messages = " << dispatchedMessageCount << std::endl;
+    uint32_t callCount = dispatchCallCount;
+    std::cout << "messages per call = " << (callCount ? static_cast<double>(dispatchedMessageCount) / callCount : 0) << std::endl;
+    wakeupLatency.display("simulator");
+}
+
+// reload axis response curves
+void Simulator::loadAxisCurves()
+{
+    if (axisCurves.loadFromFile(AxisCurvesFileName))
+    {
+        Console::getInstance().log(LogLevel::Info, "axis curves loaded from " + AxisCurvesFileName);
+    }
+    else
+    {
+        Console::getInstance().log(LogLevel::Warning, "cannot open axis curve file " + AxisCurvesFileName);
+    }
 }
\ No newline at end of file
@@ -1,13 +1,27 @@
 #pragma once
 
-#include <Windows.h>
+#ifdef _WIN32
+#include <Windows.h>     // required by SimConnect.h of the SDK
+#endif
 #include "SimConnect.h"
-#include "USB.h"
+#include "Platform.h"
+#include "JoystickLink.h"
 #include "Arbiter.h"
+#include "WriteCoalescer.h"
+#include "EventMapper.h"
+#include "TrafficTable.h"
+#include "LatencyStats.h"
+#include "AircraftProfile.h"
+#include "AxisCurves.h"
+#include "Watchdog.h"
+#include "Convert.h"
 #include <iostream>
 #include <chrono>
 #include <set>
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <string>
 
 class Simulator
 {
@@ -16,11 +30,50 @@ public:
     Simulator& operator=(Simulator const&) = delete;
     static Simulator& getInstance();
     void handler(void);
+    void service(void);     // services the simulator connection without waiting
+    void waitForService(void);      // waits for a SimConnect message, a wake-up, quit or the end of the idle time
+    void shutdown(void);
+    Event& getSimConnectEvent(void) { return simConnectEvent; }
+    Event& getWakeupEvent(void) { return wakeupEvent; }
     static void CALLBACK dispatchWrapper(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext);
-    void setJoystickLink(USBHID* pLink) { pJoystickLink = pLink; }
+    void setJoystickLink(JoystickLink* pLink);     // to be called before the link starts sending reports
     void parseReceivedData(std::vector<uint8_t> receivedData);      // parse received data fron joystick link
     void displaySimData();
     void displayReceivedJoystickData();
+    void displayWriteStatistics();
+    void displayTraffic();
+    std::string getSimDataJson();
+    std::string getJoystickDataJson();
+    std::string getWriteStatisticsJson();
+    std::string getTrafficJson();
+    TrafficTable& getTrafficTable(void) { return trafficTable; }
+    void requestRestart(void);      // closes the connection to SimConnect server and opens it again
+    LatencyStats& getWakeupLatency(void) { return wakeupLatency; }
+    void setEventDrivenDispatch(bool eventDriven) { eventDrivenDispatch = eventDriven; }
+    void setTrafficEnabled(bool enabled) { trafficEnabled = enabled; }     // periodic sweeps of AI and multiplayer traffic
+    void setWriteCoalescing(bool enabled) { writeCoalescing = enabled; }    // false = every joystick report is written at once
+    uint32_t getFlushCount(void) const { return flushCount; }
+    void displayDispatchStatistics();
+    void loadAxisCurves();
+    Watchdog& getWatchdog(void) { return watchdog; }
+    // fixed-point formats of the joystick feedback frame; the joystick firmware must decode the same formats
+    static constexpr FixedPoint16 YokeForceFormat{ 2.0 };      // aileron position - yoke X indicator
+    static constexpr FixedPoint16 ThrottleLeverFormat{ 1.0 };  // throttle lever position
+    static constexpr FixedPoint16 ForceGainFormat{ 4.0 };      // force gain from the aircraft profile
+    static constexpr FixedPoint16 FlapsLeverFormat{ 1.0 };     // flaps lever position
+    // the byte after the 'SIM' marker; 1 = float fields (no version byte), 2 = int16 fixed-point fields
+    static constexpr uint8_t FeedbackFormatVersion = 2;
+    struct FeedbackData     // data of the joystick feedback frame
+    {
+        uint8_t flapsNumHandlePositions;
+        uint8_t flapsHandleIndex;
+        double yokeForce;           // aileron position - yoke X indicator
+        uint32_t simDataFlags;
+        double throttleLeverPosition;
+        float forceGain;
+        float flapsLeverPosition;
+    };
+    static size_t packFeedback(const FeedbackData& data, uint8_t* pBuffer);     // returns the size of the frame
 private:
     Simulator();
     ~Simulator();
@@ -28,25 +81,47 @@ private:
     void subscribe(void);       // subscribes to SimConnect data
     void addToDataDefinition(HANDLE  hSimConnect, SIMCONNECT_DATA_DEFINITION_ID  defineID, std::string datumName, std::string unitsName, SIMCONNECT_DATATYPE  datumType = SIMCONNECT_DATATYPE_FLOAT64);
     void dataRequest(void);     // requests data from SimConnect server
-    void requestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID  RequestID, SIMCONNECT_DATA_DEFINITION_ID  DefineID, SIMCONNECT_PERIOD  Period);
+    void requestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID  RequestID, SIMCONNECT_DATA_DEFINITION_ID  DefineID, SIMCONNECT_PERIOD  Period, SIMCONNECT_DATA_REQUEST_FLAG  Flags = SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT);
     void procesSimData(SIMCONNECT_RECV* pData);     // processes data received from SimConnect server
+    void requestTrafficData(void);      // requests data of all aircraft objects in the traffic radius
+    void procesTrafficData(SIMCONNECT_RECV* pData);     // processes traffic data received from SimConnect server
     void setSimdataFlag(uint8_t bitPosition, bool value);
+    void closeConnection(void);     // closes connection to SimConnect server
+    void flushSimData(void);    // writes coalesced data to SimConnect server
+    void setDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID  DefineID, DWORD cbUnitSize, void* pDataSet);
+    void mapClientEvents(void);     // maps client events to simulator events
+    void applyWatchdogState(uint32_t changes);      // switches outputs of expired data streams to the safe state
+    Watchdog watchdog;      // deadlines of simulator and joystick data
     HANDLE hSimConnect{ nullptr };
     const uint8_t ShortSleep = 1;
     const uint8_t NormalSleep = 8;
     const uint16_t LongSleep = 1000;
     std::chrono::milliseconds threadSleepTime{ std::chrono::milliseconds(LongSleep) };      // idle time between handler calls
+    Event wakeupEvent{ false };     // interrupts waiting of the handler
+    Event simConnectEvent{ false };     // signaled by SimConnect when a message is waiting for dispatch
+    const std::chrono::milliseconds ConnectionRetryPeriod{ LongSleep / 2 };    // minimum time between connection attempts
+    const std::chrono::milliseconds JoystickSendPeriod{ 20 };      // period of sending data to joystick
+    bool eventDrivenDispatch{ true };       // dispatch on SimConnect event instead of polling
+    std::atomic<uint32_t> dispatchCallCount{ 0 };        // number of SimConnect_CallDispatch calls
+    std::atomic<uint32_t> dispatchedMessageCount{ 0 };   // number of messages received from SimConnect
+    std::chrono::steady_clock::time_point lastConnectionAttemptTime;
+    std::atomic<bool> restartRequest{ false };
+    LatencyStats wakeupLatency;     // handler wake-up latency after the wait timeout
     enum  DataDefineID      // SimConnect data subscription sets
     {
         SimDataReadDefinition,
         SimDataTestDefinition,
         SimDataWriteDefinition,
-        SimDataSetThrottleDefinition
+        SimDataSetThrottleDefinition,
+        SimDataTrafficDefinition,
+        SimDataAircraftDefinition
     };
     enum DataRequestID      // SimConnect data request sets
     {
         SimDataReadRequest,
-        SimDataTestRequest
+        SimDataTestRequest,
+        SimDataTrafficRequest,
+        SimDataAircraftRequest
     };
     struct SimDataRead      // SimConnect data to be send or compute for HID joystick
     {
@@ -54,15 +129,12 @@ private:
         double yokeXindicator;      // used for yoke X zero position calculations (w/o vibratiobs)
         double elevatorTrimPCT;
         double rudderTrimPCT;
-        double numberOfEngines;
         double prop1Percent;
         double prop2Percent;
-        double estimatedCruiseSpeed;
         double indicatedAirspeed;
         double rotationVelocityBodyX;   // Rotation relative to aircraft X axis (pitch / elevator)
         double rotationVelocityBodyY;   // Rotation relative to aircraft Y axis (vertical axis, yaw / rudder)
         double rotationVelocityBodyZ;   // Rotation relative to aircraft Z axis (roll / aileron)
-        double flapsNumHandlePositions; // number of flaps positions excluding position 0 (extracted)
         double flapsHandleIndex;        // flaps lever position 0..flapsNumHandlePositions
         double autopilotMaster;         // is autopilot on?
         double throttleLever1Pos;       // throttle lever 1 position
@@ -70,10 +142,16 @@ private:
         double throttleLever3Pos;       // throttle lever 3 position
         double throttleLever4Pos;       // throttle lever 4 position
     };
+    struct SimDataAircraft      // SimConnect data of the aircraft sent only on change
+    {
+        char title[256];
+        AircraftParameters parameters;
+    };
     struct JoyData  // data received from joystick device
     {
         float yokeXposition;      // requested position of yoke X axis
         float commandedThrottle;    // throttle value to be set in simulator
+        uint32_t buttons;           // bitfield of joystick buttons and switches
     };
     struct SimDataWriteGen   // general data to set in simulator
     {
@@ -97,8 +175,42 @@ private:
         double elevatorTrimIndicator;
         double elevatorTrimPCT;
     };
+    struct ClientEventMapping   // joystick input bit mapped to simulator event
+    {
+        uint8_t bitPosition;        // bit in JoyData::buttons
+        EdgeTrigger trigger;        // edge of the input that triggers the event
+        const char* simEventName;   // name of the simulator event
+    };
+    const std::vector<ClientEventMapping> clientEventMappings   // client event ID is the index in this table
+    {
+        {0, EdgeTrigger::Press, "GEAR_TOGGLE"},
+        {1, EdgeTrigger::Press, "AP_MASTER"},
+        {2, EdgeTrigger::Press, "FLAPS_INCR"},
+        {3, EdgeTrigger::Press, "FLAPS_DECR"},
+        {4, EdgeTrigger::Press, "PARKING_BRAKES"},
+        {5, EdgeTrigger::Press, "TOGGLE_NAV_LIGHTS"},
+        {6, EdgeTrigger::Press, "LANDING_LIGHTS_ON"},     // landing lights switch
+        {6, EdgeTrigger::Release, "LANDING_LIGHTS_OFF"}
+    };
+    struct SimDataTraffic   // SimConnect data of AI and multiplayer objects
+    {
+        double latitude;
+        double longitude;
+        double altitude;
+        double heading;
+        double groundSpeed;
+        double verticalSpeed;
+    };
     std::set<DWORD> dwIDs;  // set of received SimConnect dwIDs
-    USBHID* pJoystickLink{ nullptr };   // pointer to USB HID joystick device
+    static const size_t MaxUnknownIDs = 64;     // limit of the dwIDs set in long sessions
+    static const DWORD GarbageIDBase = 0x10000;     // unknown dwIDs injected by SimGarbageID fault
+    static const DWORD GarbageIDRange = 256;
+    std::atomic<uint32_t> malformedReportCount{ 0 };     // number of rejected joystick reports
+    JoystickLink* pJoystickLink{ nullptr };   // pointer to the joystick device link
+    uint32_t reportLayoutVersion{ 0 };  // version of the joystick report layout the field indexes were found for
+    int yokeXField{ ReportLayout::NoField };    // input report field indexes
+    int throttleField{ ReportLayout::NoField };
+    size_t reportMinimumSize{ 0 };      // a descriptor based report must contain all fields used by the client
     std::chrono::steady_clock::time_point lastSimDataTime;  // remembers time of last simData reception from server
     std::chrono::steady_clock::time_point lastJoystickDataTime;  // remembers time of last joystick data reception
     double lastRotationVelocityBodyX{ 0 };
@@ -109,7 +221,7 @@ private:
     double angularAccelerationZ{ 0 };       // for vibrations on joystick X axis (roll)
     SimDataRead simDataRead;    // current state of simData
     double simDataInterval{ 0 };    // time between last two simData readouts [s]
-    JoyData joyData{ 0 };    // data received from joystick
+    JoyData joyData{};    // data received from joystick
     SimDataWriteGen simDataWriteGen;      // general data to be written to simulator
     SimDataWriteThr simDataWriteThr;        // throttle data to be written to simulator
     std::chrono::steady_clock::time_point lastJoystickSendTime;  // remembers time of last joystick data sending
@@ -119,5 +231,60 @@ private:
     bool simConnectSetError{ false };   //last attempt to set in SimConnect failed?
     bool simConnectResponseError{ false };  //last connection to SimConnect failed?
     Arbiter<float> throttleArbiter;
+    static constexpr double WriteDeadband = 1e-4;   // changes of written values not exceeding this limit are not sent to simulator
+    WriteCoalescer<SimDataWriteGen> simDataWriteGenCoalescer{ WriteDeadband };
+    WriteCoalescer<SimDataWriteThr> simDataWriteThrCoalescer{ WriteDeadband };
+    std::atomic<uint32_t> setDataCallCount{ 0 };     // number of SimConnect_SetDataOnSimObject calls
+    std::atomic<uint32_t> flushCount{ 0 };      // number of flushes of the coalesced data (one per simulator frame)
+    std::atomic<bool> writeCoalescing{ true };      // writes are flushed once per simulator frame
+    EventMapper eventMapper;    // joystick inputs to client events
+    std::vector<uint32_t> clientEventsToSend;   // events taken from eventMapper for transmission
+    std::atomic<uint32_t> transmitEventCount{ 0 };   // number of SimConnect_TransmitClientEvent calls
+    TrafficTable trafficTable;      // AI and multiplayer objects around the user aircraft
+    static const DWORD TrafficRadius = 200000;      // radius of traffic data request [m]
+    const std::chrono::milliseconds TrafficRequestPeriod{ 33 };     // traffic table update period
+    const std::chrono::milliseconds TrafficReplyTimeout{ 1000 };    // a sweep without its last reply is abandoned after this time
+    std::atomic<bool> trafficEnabled{ false };      // the sweeps load the simulator - they run only when requested
+    std::atomic<uint32_t> trafficTimeoutCount{ 0 };     // sweeps abandoned for a lost reply
+    std::chrono::steady_clock::time_point lastTrafficRequestTime;  // remembers time of last traffic data request
+    bool trafficRequestPending{ false };    // traffic data request has not been completed yet
+    ProfileCache profileCache;      // profiles of all aircraft used in this session
+    std::string aircraftTitle;
+    std::atomic<const AircraftProfile*> pAircraftProfile{ nullptr };   // profile of the current aircraft
+    float forceGain{ 1.0f };        // force feedback gain for the current airspeed
+    float flapsLeverPosition{ 0 };  // flaps detent position for the current flaps handle index
+    AxisCurves axisCurves;      // response curves of joystick axes
+    const std::string AxisCurvesFileName = "curves.txt";
+    struct SimDataSnapshot      // simulator data copied for the console and remote clients
+    {
+        std::chrono::steady_clock::time_point lastSimDataTime;
+        double simDataInterval{ 0 };
+        bool isConnected{ false };
+        uint32_t simDataFlags{ 0 };
+        SimDataRead simDataRead{};
+        double angularAccelerationX{ 0 };
+        double angularAccelerationY{ 0 };
+        double angularAccelerationZ{ 0 };
+        float forceGain{ 0 };
+        float flapsLeverPosition{ 0 };
+        std::string aircraftTitle;
+        AircraftParameters aircraftParameters{};
+        bool hasProfile{ false };
+        size_t cachedProfiles{ 0 };
+    };
+    struct JoystickSnapshot     // joystick data copied for the console and remote clients
+    {
+        std::chrono::steady_clock::time_point lastJoystickDataTime;
+        JoyData joyData{};
+        SimDataWriteGen simDataWriteGen{};
+        SimDataWriteThr simDataWriteThr{};
+    };
+    void updateSimDataSnapshot(void);       // called by the simulator thread
+    void updateJoystickSnapshot(void);      // called by the joystick link thread
+    SimDataSnapshot getSimDataSnapshot(void);
+    JoystickSnapshot getJoystickSnapshot(void);
+    std::mutex snapshotMutex;       // the snapshots are read by the console and command server threads
+    SimDataSnapshot simDataSnapshot;
+    JoystickSnapshot joystickSnapshot;
 };
 
@@ -0,0 +1,118 @@
+#include "ThreadConfig.h"
+#include "Console.h"
+#include <timeapi.h>
+#include <sstream>
+#include <map>
+#include <vector>
+
+ThreadConfig& ThreadConfig::getInstance()
+{
+    static ThreadConfig instance;
+    return instance;
+}
+
+// set priority class, minimum resident working set and timer resolution of the process
+void ThreadConfig::setProcessParameters(const ProcessParameters& parameters)
+{
+    if (!SetPriorityClass(GetCurrentProcess(), parameters.priorityClass))
+    {
+        Console::getInstance().log(LogLevel::Warning, "failed to set process priority class, error code=" + std::to_string(GetLastError()));
+    }
+
+    if (parameters.minWorkingSetSize && parameters.maxWorkingSetSize)
+    {
+        // the hard minimum keeps this much of the working set resident even under memory pressure,
+        // so the I/O threads do not page fault; the maximum stays a soft limit
+        if (!SetProcessWorkingSetSizeEx(GetCurrentProcess(), parameters.minWorkingSetSize, parameters.maxWorkingSetSize,
+            QUOTA_LIMITS_HARDWS_MIN_ENABLE | QUOTA_LIMITS_HARDWS_MAX_DISABLE))
+        {
+            Console::getInstance().log(LogLevel::Warning, "failed to set process working set size, error code=" + std::to_string(GetLastError()));
+        }
+    }
+
+    if (parameters.timerResolution)
+    {
+        if (timeBeginPeriod(parameters.timerResolution) == TIMERR_NOERROR)
+        {
+            currentTimerResolution = parameters.timerResolution;
+        }
+        else
+        {
+            Console::getInstance().log(LogLevel::Warning, "failed to set timer resolution");
+        }
+    }
+}
+
+// set priority and processor affinity of the thread
+void ThreadConfig::setThreadParameters(HANDLE hThread, const ThreadParameters& parameters, std::string name)
+{
+    std::stringstream ss;
+    if (!SetThreadPriority(hThread, parameters.priority))
+    {
+        ss << "failed to set priority of " << name.c_str() << " thread, error code=" << GetLastError();
+        Console::getInstance().log(LogLevel::Warning, ss.str());
+        return;
+    }
+
+    if (parameters.affinityMask && (SetThreadAffinityMask(hThread, parameters.affinityMask) == 0))
+    {
+        ss << "failed to set affinity of " << name.c_str() << " thread, error code=" << GetLastError();
+        Console::getInstance().log(LogLevel::Warning, ss.str());
+        return;
+    }
+
+    ss << name.c_str() << " thread priority=" << parameters.priority << " affinity=0x" << std::hex << parameters.affinityMask;
+    Console::getInstance().log(LogLevel::Debug, ss.str());
+}
+
+// restore system settings changed by setProcessParameters
+void ThreadConfig::restoreProcessParameters(void)
+{
+    if (currentTimerResolution)
+    {
+        timeEndPeriod(currentTimerResolution);
+        currentTimerResolution = 0;
+    }
+}
+
+// the processors are taken from the affinity mask of the process, so the mask never exceeds DWORD_PTR
+// position 0 is the last processor of the process, 1 the one before it, etc.
+DWORD_PTR ThreadConfig::getProcessorFromEnd(unsigned int position)
+{
+    DWORD_PTR processAffinityMask;
+    DWORD_PTR systemAffinityMask;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processAffinityMask, &systemAffinityMask))
+    {
+        return 0;
+    }
+
+    const int MaskBits = 8 * sizeof(DWORD_PTR);
+    std::vector<DWORD_PTR> processors;
+    for (int bit = MaskBits - 1; bit >= 0; bit--)
+    {
+        DWORD_PTR mask = static_cast<DWORD_PTR>(1) << bit;
+        if (processAffinityMask & mask)
+        {
+            processors.push_back(mask);
+        }
+    }
+    return ((processors.size() >= 4) && (position < processors.size())) ? processors[position] : 0;
+}
+
+bool ThreadConfig::getPriorityClass(const std::string& name, DWORD& priorityClass)
+{
+    static const std::map<std::string, DWORD> priorityClasses
+    {
+        {"normal", NORMAL_PRIORITY_CLASS},
+        {"abovenormal", ABOVE_NORMAL_PRIORITY_CLASS},
+        {"high", HIGH_PRIORITY_CLASS},
+        {"realtime", REALTIME_PRIORITY_CLASS}
+    };
+    auto it = priorityClasses.find(name);
+    if (it == priorityClasses.end())
+    {
+        return false;
+    }
+    priorityClass = it->second;
+    return true;
+}
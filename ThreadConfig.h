@@ -0,0 +1,36 @@
+#pragma once
+#pragma comment(lib, "winmm.lib")
+
+#include <Windows.h>
+#include <string>
+
+struct ThreadParameters     // scheduling parameters of a single thread
+{
+    int priority{ THREAD_PRIORITY_NORMAL };
+    DWORD_PTR affinityMask{ 0 };    // 0 = run on any processor
+};
+
+struct ProcessParameters    // scheduling and memory parameters of the process
+{
+    DWORD priorityClass{ NORMAL_PRIORITY_CLASS };
+    SIZE_T minWorkingSetSize{ 0 };      // hard minimum of resident memory; 0 = do not change the working set
+    SIZE_T maxWorkingSetSize{ 0 };      // soft maximum
+    UINT timerResolution{ 0 };      // system timer resolution [ms]; 0 = do not change
+};
+
+// applies real-time scheduling parameters to the I/O threads and the process
+class ThreadConfig
+{
+public:
+    ThreadConfig(ThreadConfig const&) = delete;
+    ThreadConfig& operator=(ThreadConfig const&) = delete;
+    static ThreadConfig& getInstance();
+    void setProcessParameters(const ProcessParameters& parameters);
+    void setThreadParameters(HANDLE hThread, const ThreadParameters& parameters, std::string name);
+    void restoreProcessParameters(void);    // restores the system timer resolution
+    DWORD_PTR getProcessorFromEnd(unsigned int position);      // affinity mask of the processor at the position counted from the last one of the process; 0 if the process has fewer than 4 processors
+    static bool getPriorityClass(const std::string& name, DWORD& priorityClass);       // priority class of the name (normal, abovenormal, high, realtime)
+private:
+    ThreadConfig() = default;
+    UINT currentTimerResolution{ 0 };
+};
@@ -0,0 +1,129 @@
+#include "TrafficTable.h"
+
+// insert a new object or update the existing one
+void TrafficTable::update(const TrafficObject& object)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    size_t index;
+    auto it = indexOf.find(object.objectID);
+    if (it == indexOf.end())
+    {
+        // a new object - append it at the end of arrays
+        index = objectID.size();
+        indexOf[object.objectID] = index;
+        objectID.push_back(object.objectID);
+        latitude.push_back(0);
+        longitude.push_back(0);
+        altitude.push_back(0);
+        heading.push_back(0);
+        groundSpeed.push_back(0);
+        verticalSpeed.push_back(0);
+        lastSweep.push_back(0);
+    }
+    else
+    {
+        index = it->second;
+    }
+
+    latitude[index] = object.latitude;
+    longitude[index] = object.longitude;
+    altitude[index] = object.altitude;
+    heading[index] = object.heading;
+    groundSpeed[index] = object.groundSpeed;
+    verticalSpeed[index] = object.verticalSpeed;
+    lastSweep[index] = sweepCount;
+}
+
+// remove objects which have disappeared and start a new sweep
+void TrafficTable::endSweep(void)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    size_t index = 0;
+    while (index < objectID.size())
+    {
+        if (lastSweep[index] != sweepCount)
+        {
+            // the last object is moved to this index - check the same index again
+            remove(index);
+        }
+        else
+        {
+            index++;
+        }
+    }
+    sweepCount++;
+}
+
+// remove all objects
+void TrafficTable::clear(void)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    indexOf.clear();
+    objectID.clear();
+    latitude.clear();
+    longitude.clear();
+    altitude.clear();
+    heading.clear();
+    groundSpeed.clear();
+    verticalSpeed.clear();
+    lastSweep.clear();
+}
+
+// number of objects in the table
+size_t TrafficTable::size(void)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return objectID.size();
+}
+
+// get state of the object with the given ID
+bool TrafficTable::find(uint32_t id, TrafficObject& object)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    auto it = indexOf.find(id);
+    if (it == indexOf.end())
+    {
+        return false;
+    }
+    size_t index = it->second;
+    object = { id, latitude[index], longitude[index], altitude[index], heading[index], groundSpeed[index], verticalSpeed[index] };
+    return true;
+}
+
+// get state of all objects
+void TrafficTable::getSnapshot(std::vector<TrafficObject>& objects)
+{
+    std::lock_guard<std::mutex> lock(tableMutex);
+    objects.resize(objectID.size());
+    for (size_t index = 0; index < objectID.size(); index++)
+    {
+        objects[index] = { objectID[index], latitude[index], longitude[index], altitude[index], heading[index], groundSpeed[index], verticalSpeed[index] };
+    }
+}
+
+// remove the object by moving the last object to its place
+void TrafficTable::remove(size_t index)
+{
+    size_t lastIndex = objectID.size() - 1;
+    indexOf.erase(objectID[index]);
+    if (index != lastIndex)
+    {
+        objectID[index] = objectID[lastIndex];
+        latitude[index] = latitude[lastIndex];
+        longitude[index] = longitude[lastIndex];
+        altitude[index] = altitude[lastIndex];
+        heading[index] = heading[lastIndex];
+        groundSpeed[index] = groundSpeed[lastIndex];
+        verticalSpeed[index] = verticalSpeed[lastIndex];
+        lastSweep[index] = lastSweep[lastIndex];
+        indexOf[objectID[index]] = index;
+    }
+    objectID.pop_back();
+    latitude.pop_back();
+    longitude.pop_back();
+    altitude.pop_back();
+    heading.pop_back();
+    groundSpeed.pop_back();
+    verticalSpeed.pop_back();
+    lastSweep.pop_back();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+struct TrafficObject    // state of a single AI or multiplayer object
+{
+    uint32_t objectID;
+    double latitude;        // [deg]
+    double longitude;       // [deg]
+    double altitude;        // [ft]
+    double heading;         // true heading [deg]
+    double groundSpeed;     // [kts]
+    double verticalSpeed;   // [ft/min]
+};
+
+// table of traffic objects stored as structure of arrays and keyed by object ID
+// objects not reported in the last completed sweep are removed from the table
+class TrafficTable
+{
+public:
+    void update(const TrafficObject& object);   // inserts or updates the object in the current sweep
+    void endSweep(void);        // removes objects which have not been updated in the current sweep
+    void clear(void);
+    size_t size(void);
+    bool find(uint32_t id, TrafficObject& object);     // returns true if the object exists
+    void getSnapshot(std::vector<TrafficObject>& objects);    // copies all objects to the vector
+    uint32_t getSweepCount(void) const { return sweepCount; }
+private:
+    void remove(size_t index);      // removes the object at the index in O(1)
+    std::mutex tableMutex;
+    std::unordered_map<uint32_t, size_t> indexOf;   // object ID to array index
+    std::vector<uint32_t> objectID;
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;
+    std::vector<double> heading;
+    std::vector<double> groundSpeed;
+    std::vector<double> verticalSpeed;
+    std::vector<uint32_t> lastSweep;    // sweep in which the object has been updated last time
+    std::atomic<uint32_t> sweepCount{ 0 };       // number of the current sweep
+};
@@ -2,11 +2,15 @@
 
 #include "USB.h"
 #include "Console.h"
+#include "FaultInjector.h"
+#include "Profiler.h"
+#include "ReportDescriptor.h"
 #include <SetupAPI.h>
 #include <iostream>
 #include <sstream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 USBHID::USBHID(USHORT VID, USHORT PID, uint8_t collection) :
     VID(VID),
@@ -17,6 +21,7 @@ USBHID::USBHID(USHORT VID, USHORT PID, uint8_t collection) :
     receiveOverlappedData.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
     memset(&sendOverlappedData, 0, sizeof(sendOverlappedData));
     sendOverlappedData.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    wakeupEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
     std::stringstream ss;
     ss << std::hex << "USB HID device with VID=" << VID << " PID=" << PID;
     VidPid = ss.str();
@@ -26,10 +31,12 @@ USBHID::USBHID(USHORT VID, USHORT PID, uint8_t collection) :
         collectionStr += L"0";
     }
     collectionStr += std::to_wstring(collection);
+    Console::getInstance().registerCommand("usbrestart", "reconnect USB joystick", std::bind(&USBHID::requestRestart, this), true);
 }
 
 USBHID::~USBHID()
 {
+    CloseHandle(wakeupEvent);
 }
 
 // USB link handler to be called in a separate thread
@@ -38,40 +45,90 @@ void USBHID::handler()
     // stay in this loop until the user requests quit
     while (!Console::getInstance().isQuitRequest())
     {
-        if (isOpen)
+        service();
+
+        // wait for a new data from joystick or for the next connection attempt
+        HANDLE handles[] = { Console::getInstance().getQuitEvent().getNativeHandle(), wakeupEvent, receiveOverlappedData.hEvent };
+        DWORD numberOfHandles = isOpen ? 3 : 2;
+        DWORD waitTime = isOpen ? ConnectionOnPeriod : ConnectionOffPeriod;
+        auto waitStartTime = std::chrono::steady_clock::now();
+        if ((WaitForMultipleObjects(numberOfHandles, handles, FALSE, waitTime) == WAIT_TIMEOUT) && isOpen)
         {
-            // check a new data from joystick
-            if (isDataReceived())
+            wakeupLatency.addSample(std::chrono::steady_clock::now() - waitStartTime - std::chrono::milliseconds(ConnectionOnPeriod));
+        }
+    }
+
+    shutdown();
+}
+
+// service the USB link without waiting - to be called when any of the link events is signaled or periodically
+void USBHID::service()
+{
+    PROFILE_ZONE("USBHID::service");
+    if (restartRequest.exchange(false) && isOpen)
+    {
+        // the connection will be opened again below
+        disableReception();
+        closeConnection();
+    }
+
+    if (FAULT_ACTIVE(UsbDisconnect) && isOpen)
+    {
+        // the device disappears; it cannot be opened until the fault ends
+        disableReception();
+        closeConnection();
+    }
+
+    if (isOpen)
+    {
+        // check a new data from joystick
+        if (isDataReceived())
+        {
+            if (!isReadCompleted())
             {
-                // call reveived data parsing function
-                if (parseCallback)
-                {
-                    parseCallback(std::vector<uint8_t>(receiveBuffer, receiveBuffer + HidBufferSize));
-                }
-                enableReception();
+                // the read failed (e.g. device unplugged) - the simulator switches the joystick data to the safe state
+                Console::getInstance().log(LogLevel::Error, "USB data read error=" + std::to_string(GetLastError()));
+                disableReception();
+                closeConnection();
+                return;
+            }
+            // call reveived data parsing function
+            if (FAULT_ACTIVE(UsbDelayReport))
+            {
+                std::this_thread::sleep_for(FaultInjector::DelayTime);
+            }
+            if (parseCallback && !FAULT_ACTIVE(UsbDropReport))
+            {
+                DWORD reportSize = FAULT_ACTIVE(UsbShortReport) ? (std::min)(inputReportSize, static_cast<DWORD>(FaultInjector::ShortReportSize)) : inputReportSize;
+                parseCallback(std::vector<uint8_t>(receiveBuffer, receiveBuffer + reportSize));
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(ConnectionOnPeriod));
+            enableReception();
         }
-        else
+    }
+    else if ((std::chrono::steady_clock::now() - lastConnectionAttemptTime >= std::chrono::milliseconds(ConnectionOffPeriod)) &&
+        !FAULT_ACTIVE(UsbDisconnect))
+    {
+        // no USB connection - try to connect
+        lastConnectionAttemptTime = std::chrono::steady_clock::now();
+        if (openConnection())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(ConnectionOffPeriod));
-            // no USB connection - try to connect
-            if (openConnection())
+            // connection has been opened
+            // enable reception for the first time
+            if (enableReception())
             {
-                // connection has been opened
-                // enable reception for the first time
-                if (enableReception())
-                {
-                    Console::getInstance().log(LogLevel::Info, "USB data reception enabled");
-                }
-                else
-                {
-                    Console::getInstance().log(LogLevel::Error, "USB data reception enabling failed");
-                }
+                Console::getInstance().log(LogLevel::Info, "USB data reception enabled");
+            }
+            else
+            {
+                Console::getInstance().log(LogLevel::Error, "USB data reception enabling failed");
             }
         }
     }
+}
 
+// close the USB link on exit
+void USBHID::shutdown()
+{
     if (isOpen)
     {
         disableReception();
@@ -79,6 +136,13 @@ void USBHID::handler()
     }
 }
 
+// request closing and reopening the connection from any thread
+void USBHID::requestRestart(void)
+{
+    restartRequest = true;
+    SetEvent(wakeupEvent);
+}
+
 // find the USB device and open the connection to it
 bool USBHID::openConnection()
 {
@@ -160,6 +224,7 @@ bool USBHID::openConnection()
                             if (fileHandle != INVALID_HANDLE_VALUE)
                             {
                                 isOpen = true;
+                                readReportLayout();
                                 std::stringstream ss;
                                 ss << "Connection to " << VidPid.c_str();
                                 if (collection)
@@ -205,13 +270,94 @@ bool USBHID::openConnection()
 }
 
 
+// build the field extraction plan of the input report
+// Windows does not expose the raw report descriptor, so the capabilities listed by the system parser
+// are probed with HidP_SetUsageValue/HidP_SetUsages (see probeReportLayout)
+void USBHID::readReportLayout(void)
+{
+    reportLayout.clear();
+    inputReportSize = outputReportSize = DefaultReportSize;
+    reportLayoutVersion++;
+
+    PHIDP_PREPARSED_DATA pPreparsedData;
+    if (!HidD_GetPreparsedData(fileHandle, &pPreparsedData))
+    {
+        Console::getInstance().log(LogLevel::Warning, "cannot read HID report descriptor, error code=" + std::to_string(GetLastError()));
+        return;
+    }
+
+    HIDP_CAPS caps;
+    if (HidP_GetCaps(pPreparsedData, &caps) == HIDP_STATUS_SUCCESS)
+    {
+        if ((caps.InputReportByteLength > 0) && (caps.InputReportByteLength <= ReceiveBufferSize))
+        {
+            inputReportSize = caps.InputReportByteLength;
+        }
+        if (caps.OutputReportByteLength <= SendBufferSize)
+        {
+            outputReportSize = caps.OutputReportByteLength;
+        }
+        if (outputReportSize == 0)
+        {
+            Console::getInstance().log(LogLevel::Info, "device has no output report - feedback is not sent");
+        }
+
+        // capabilities of the input reports
+        std::vector<ValueCaps> valueCaps;
+        USHORT numberOfValueCaps = caps.NumberInputValueCaps;
+        std::vector<HIDP_VALUE_CAPS> hidValueCaps(numberOfValueCaps);
+        if (numberOfValueCaps && (HidP_GetValueCaps(HidP_Input, hidValueCaps.data(), &numberOfValueCaps, pPreparsedData) == HIDP_STATUS_SUCCESS))
+        {
+            for (auto const& cap : hidValueCaps)
+            {
+                valueCaps.push_back({ cap.ReportID, cap.UsagePage, cap.LinkCollection,
+                    cap.IsRange ? cap.Range.UsageMin : cap.NotRange.Usage, cap.IsRange ? cap.Range.UsageMax : cap.NotRange.Usage,
+                    cap.BitSize, cap.ReportCount, static_cast<int32_t>(cap.LogicalMin), static_cast<int32_t>(cap.LogicalMax) });
+            }
+        }
+        std::vector<ButtonCaps> buttonCaps;
+        USHORT numberOfButtonCaps = caps.NumberInputButtonCaps;
+        std::vector<HIDP_BUTTON_CAPS> hidButtonCaps(numberOfButtonCaps);
+        if (numberOfButtonCaps && (HidP_GetButtonCaps(HidP_Input, hidButtonCaps.data(), &numberOfButtonCaps, pPreparsedData) == HIDP_STATUS_SUCCESS))
+        {
+            for (auto const& cap : hidButtonCaps)
+            {
+                buttonCaps.push_back({ cap.ReportID, cap.UsagePage, cap.LinkCollection,
+                    cap.IsRange ? cap.Range.UsageMin : cap.NotRange.Usage, cap.IsRange ? cap.Range.UsageMax : cap.NotRange.Usage });
+            }
+        }
+
+        // the system parser sets the usages in the probe reports
+        auto setUsage = [pPreparsedData](std::vector<uint8_t>& report, uint16_t usagePage, uint16_t linkCollection, uint16_t usage, uint32_t value, bool isButton) -> bool
+        {
+            if (isButton)
+            {
+                USAGE usageList[] = { usage };
+                ULONG usageLength = 1;
+                return HidP_SetUsages(HidP_Input, usagePage, linkCollection, usageList, &usageLength, pPreparsedData,
+                    reinterpret_cast<PCHAR>(report.data()), static_cast<ULONG>(report.size())) == HIDP_STATUS_SUCCESS;
+            }
+            return HidP_SetUsageValue(HidP_Input, usagePage, linkCollection, usage, value, pPreparsedData,
+                reinterpret_cast<PCHAR>(report.data()), static_cast<ULONG>(report.size())) == HIDP_STATUS_SUCCESS;
+        };
+        probeReportLayout(reportLayout, collection, caps.InputReportByteLength, valueCaps, buttonCaps, setUsage);
+    }
+    HidD_FreePreparsedData(pPreparsedData);
+
+    std::stringstream ss;
+    ss << "input report size=" << inputReportSize << " value fields=" << reportLayout.getNumberOfValueFields();
+    Console::getInstance().log(LogLevel::Info, ss.str());
+}
+
 // closes connection to the device
 void USBHID::closeConnection()
 {
+    FAULT_DETECTED(Joystick);
     if (fileHandle != INVALID_HANDLE_VALUE)
     {
         CloseHandle(fileHandle);
         fileHandle = INVALID_HANDLE_VALUE;
+        ResetEvent(receiveOverlappedData.hEvent);   // the cancelled read must not look like received data
         Console::getInstance().log(LogLevel::Info, "closing connection to " + VidPid);
     }
     else
@@ -228,8 +374,15 @@ bool USBHID::enableReception(void)
 {
     if (isOpen && (fileHandle != INVALID_HANDLE_VALUE))
     {
-        auto result = ReadFile(fileHandle, receiveBuffer, HidBufferSize, &receivedDataCount, &receiveOverlappedData);
+        auto result = ReadFile(fileHandle, receiveBuffer, inputReportSize, &receivedDataCount, &receiveOverlappedData);
         DWORD lastError = GetLastError();
+        if ((result == 0) && (lastError != ERROR_IO_PENDING))
+        {
+            // the read cannot be started - the link is lost
+            Console::getInstance().log(LogLevel::Error, "USB read error=" + std::to_string(lastError));
+            closeConnection();
+            return false;
+        }
         if ((result != 0) && (lastError != 997))
         {
             // when OK, expected values are res=0, cnt=0 and err=997
@@ -260,14 +413,27 @@ bool USBHID::isDataReceived(void)
     return (WaitForSingleObject(receiveOverlappedData.hEvent, 0) == WAIT_OBJECT_0);
 }
 
+// return true if the signaled read has completed successfully
+bool USBHID::isReadCompleted(void)
+{
+    DWORD transferredCount = 0;
+    return GetOverlappedResult(fileHandle, &receiveOverlappedData, &transferredCount, FALSE) != 0;
+}
+
 // send data to USB HID device
 bool USBHID::sendData(uint8_t* dataToSend)
 {
-    if (isOpen && (fileHandle != INVALID_HANDLE_VALUE))
+    PROFILE_ZONE("USBHID::sendData");
+    if (isOpen && (fileHandle != INVALID_HANDLE_VALUE) && (outputReportSize > 0))
     {
         // get overlapped result without waiting
         bool overlappedResult = GetOverlappedResult(fileHandle, &sendOverlappedData, &sendDataCount, FALSE);
         DWORD lastError = GetLastError();
+        if (FAULT_ACTIVE(UsbSendError))
+        {
+            overlappedResult = false;
+            lastError = ERROR_GEN_FAILURE;
+        }
         // if the process is pending, return without action
         if (!overlappedResult && lastError == ERROR_IO_PENDING)
         {
@@ -278,6 +444,7 @@ bool USBHID::sendData(uint8_t* dataToSend)
         else if (!overlappedResult)
         {
             // reset overlapped data
+            CloseHandle(sendOverlappedData.hEvent);
             memset(&sendOverlappedData, 0, sizeof(sendOverlappedData));
             sendOverlappedData.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
             Console::getInstance().log(LogLevel::Error, "USB data send error=" + std::to_string(lastError));
@@ -295,8 +462,8 @@ bool USBHID::sendData(uint8_t* dataToSend)
         }
         // send data every time if only process in not pending
         sendBuffer[0] = collection;
-        memcpy(sendBuffer+1, dataToSend, HidBufferSize-1);
-        WriteFile(fileHandle, sendBuffer, HidBufferSize, NULL, &sendOverlappedData);
+        memcpy(sendBuffer+1, dataToSend, outputReportSize-1);
+        WriteFile(fileHandle, sendBuffer, outputReportSize, NULL, &sendOverlappedData);
         return true;
     }
     return false;
@@ -7,22 +7,34 @@
 #include <string>
 #include<vector>
 #include <functional>
+#include <chrono>
+#include <atomic>
+#include "LatencyStats.h"
+#include "JoystickLink.h"
 
 
-class USBHID
+class USBHID : public JoystickLink
 {
 public:
     USBHID(USHORT VID, USHORT PID, uint8_t collection);
     ~USBHID();
     void handler();
+    void service();     // services the link without waiting
+    void shutdown();
+    HANDLE getReceiveEvent(void) const { return receiveOverlappedData.hEvent; }
+    HANDLE getWakeupEvent(void) const { return wakeupEvent; }
     bool openConnection();
     void closeConnection();
-    bool isConnectionOpen() const { return isOpen; }
+    bool isConnectionOpen() const override { return isOpen; }
     bool enableReception(void);
     void disableReception(void); // clears the reception event (no signals until enabled again)
     bool isDataReceived(void);
-    void setParseFunction(std::function<void(std::vector<uint8_t>)> fn) { parseCallback = fn; }
-    bool sendData(uint8_t* dataToSend);
+    bool isReadCompleted(void);     // false if the signaled read failed
+    bool sendData(uint8_t* dataToSend) override;
+    void requestRestart(void);      // closes the connection and opens it again
+    LatencyStats& getWakeupLatency(void) { return wakeupLatency; }
+    const ReportLayout& getReportLayout(void) const override { return reportLayout; }
+    uint32_t getReportLayoutVersion(void) const override { return reportLayoutVersion; }
 private:
     USHORT VID;
     USHORT PID;
@@ -34,11 +46,12 @@ private:
     std::wstring collectionStr;
     static const size_t ReceiveBufferSize = 260;
     static const size_t SendBufferSize = 65;
-    const DWORD HidBufferSize = collection ? 64 : 65; // report id (!=0) + 63 bytes of payload or report id (==0) + 64 bytes of payload
+    const DWORD DefaultReportSize = collection ? 64 : 65; // report id (!=0) + 63 bytes of payload or report id (==0) + 64 bytes of payload
+    DWORD inputReportSize{ DefaultReportSize };       // report sizes read from device capabilities
+    DWORD outputReportSize{ DefaultReportSize };     // 0 = the device has no output report
     uint8_t receiveBuffer[ReceiveBufferSize];
     DWORD receivedDataCount;
     OVERLAPPED receiveOverlappedData;
-    std::function<void(std::vector<uint8_t>)> parseCallback{ nullptr };
     OVERLAPPED sendOverlappedData;
     DWORD sendDataCount;
     uint8_t sendBuffer[SendBufferSize];
@@ -46,5 +59,12 @@ private:
     static const uint8_t SendErrorLimit = 10;
     static const int ConnectionOnPeriod = 5;        //ms
     static const int ConnectionOffPeriod = 100;     //ms
+    HANDLE wakeupEvent;     // interrupts waiting of the handler
+    std::chrono::steady_clock::time_point lastConnectionAttemptTime;
+    std::atomic<bool> restartRequest{ false };
+    LatencyStats wakeupLatency;     // handler wake-up latency after the wait timeout
+    void readReportLayout(void);    // builds the input report layout from the device capabilities
+    ReportLayout reportLayout;      // field extraction plan of the input report
+    uint32_t reportLayoutVersion{ 0 };  // incremented with every new layout
 };
 
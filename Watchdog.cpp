@@ -0,0 +1,79 @@
+#include "Watchdog.h"
+#include "Console.h"
+#include "Platform.h"
+#include <iostream>
+
+Watchdog::Watchdog()
+{
+    for (int stream = 0; stream < NumberOfStreams; stream++)
+    {
+        lastFeedTime[stream] = 0;
+        expired[stream] = true;
+        timeoutCount[stream] = 0;
+    }
+    setDeadline(SimData, std::chrono::milliseconds(200));
+    // HID devices may report on change only - a steady stick sends nothing, so only the link loss expires the joystick data
+    setDeadline(JoystickData, std::chrono::milliseconds(0));
+}
+
+void Watchdog::setDeadline(Stream stream, std::chrono::milliseconds deadline)
+{
+    deadlines[stream] = std::chrono::duration_cast<std::chrono::steady_clock::duration>(deadline).count();
+}
+
+void Watchdog::feed(Stream stream)
+{
+    lastFeedTime[stream] = SessionClock::now().time_since_epoch().count();
+}
+
+void Watchdog::expire(Stream stream)
+{
+    lastFeedTime[stream] = 0;
+}
+
+// evaluate all deadlines - one clock read and a comparison per stream
+// the caller applies the safe state of every stream reported as changed
+uint32_t Watchdog::check(void)
+{
+    uint32_t changes = 0;
+    auto now = SessionClock::now().time_since_epoch().count();
+    for (int stream = 0; stream < NumberOfStreams; stream++)
+    {
+        bool isExpired = (lastFeedTime[stream] == 0) || ((deadlines[stream] > 0) && (now - lastFeedTime[stream] > deadlines[stream]));
+        if (isExpired != expired[stream])
+        {
+            expired[stream] = isExpired;
+            changes |= 1u << stream;
+            if (isExpired)
+            {
+                timeoutCount[stream]++;
+            }
+            Console::getInstance().log(isExpired ? LogLevel::Warning : LogLevel::Info,
+                std::string(streamNames[stream]) + (isExpired ? " timeout" : " restored"));
+        }
+    }
+    return changes;
+}
+
+void Watchdog::display(void) const
+{
+    auto now = SessionClock::now().time_since_epoch().count();
+    std::cout << "========== Data watchdog ==========" << std::endl;
+    for (int stream = 0; stream < NumberOfStreams; stream++)
+    {
+        std::cout << streamNames[stream] << ": " << (expired[stream] ? "expired" : "valid");
+        if (deadlines[stream] > 0)
+        {
+            std::cout << ", deadline [ms] = " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::duration(deadlines[stream])).count();
+        }
+        else
+        {
+            std::cout << ", deadline = link loss only";
+        }
+        if (lastFeedTime[stream] != 0)
+        {
+            std::cout << ", data age [ms] = " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::duration(now - lastFeedTime[stream])).count();
+        }
+        std::cout << ", timeouts = " << timeoutCount[stream] << std::endl;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <atomic>
+
+// detects data streams which stopped updating within their deadlines
+class Watchdog
+{
+public:
+    enum Stream
+    {
+        SimData,        // aircraft data from SimConnect
+        JoystickData,   // input reports from the joystick
+        NumberOfStreams
+    };
+    Watchdog();
+    void setDeadline(Stream stream, std::chrono::milliseconds deadline);   // 0 = the stream expires only when its link is lost
+    void feed(Stream stream);       // marks new data of the stream; may be called from any thread
+    void expire(Stream stream);     // the link of the stream is lost; the stream stays expired until the next feed
+    uint32_t check(void);       // evaluates all deadlines; returns bit mask of streams which changed state
+    bool isExpired(Stream stream) const { return expired[stream]; }
+    void display(void) const;
+private:
+    const char* streamNames[NumberOfStreams] = { "simulator data", "joystick data" };
+    std::atomic<std::chrono::steady_clock::rep> lastFeedTime[NumberOfStreams];     // steady clock ticks
+    std::atomic<std::chrono::steady_clock::rep> deadlines[NumberOfStreams];        // steady clock ticks
+    std::atomic<bool> expired[NumberOfStreams];     // streams start expired until the first data arrives
+    std::atomic<uint32_t> timeoutCount[NumberOfStreams];
+};
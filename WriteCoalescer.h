@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <mutex>
+#include <atomic>
+
+// accumulates data to be written to SimConnect and releases it at most once per flush
+// the data structure T must consist of double fields only (as SimConnect FLOAT64 data definitions)
+template <class T>
+class WriteCoalescer
+{
+public:
+    WriteCoalescer(double deadband) : deadband(deadband) {}
+    void update(const T& data, bool forced = false);     // store new data to be written
+    bool getDataToFlush(T& data);       // returns true and copies data if the write is required
+    void invalidate(void);      // forces the next update to be written (e.g. after reconnection)
+    uint32_t getUpdateCount(void) const { return updateCount; }
+    uint32_t getWriteCount(void) const { return writeCount; }
+    uint32_t getUnchangedCount(void) const { return unchangedCount; }
+    uint32_t getMergedCount(void) const { return mergedCount; }
+private:
+    static_assert(sizeof(T) % sizeof(double) == 0, "WriteCoalescer requires a structure of doubles");
+    static const size_t NumberOfFields = sizeof(T) / sizeof(double);
+    bool isChanged(const T& data) const;
+    std::mutex dataMutex;
+    double deadband;        // changes not greater than this value are not written
+    T pending;              // data waiting for the next flush
+    T lastWritten;          // data written in the last flush
+    bool isDirty{ false };  // pending data differs from the last written data
+    bool isValid{ false };  // lastWritten contains data actually written to the simulator
+    std::atomic<uint32_t> updateCount{ 0 };      // number of update calls
+    std::atomic<uint32_t> writeCount{ 0 };       // number of flushed writes
+    std::atomic<uint32_t> unchangedCount{ 0 };   // updates skipped for no change within the deadband
+    std::atomic<uint32_t> mergedCount{ 0 };      // updates overwritten by a newer update before the flush
+};
+
+template <class T>
+void WriteCoalescer<T>::update(const T& data, bool forced)
+{
+    std::lock_guard<std::mutex> lock(dataMutex);
+    updateCount++;
+    if (!forced && isValid && !isChanged(data))
+    {
+        // no change since last write - nothing to be sent
+        if (isDirty)
+        {
+            // the pending value returned to the written one - cancel the write
+            isDirty = false;
+            mergedCount++;
+        }
+        unchangedCount++;
+        return;
+    }
+    if (isDirty)
+    {
+        // previous pending data is replaced before it has been flushed
+        mergedCount++;
+    }
+    pending = data;
+    isDirty = true;
+}
+
+template <class T>
+bool WriteCoalescer<T>::getDataToFlush(T& data)
+{
+    std::lock_guard<std::mutex> lock(dataMutex);
+    if (!isDirty)
+    {
+        return false;
+    }
+    data = lastWritten = pending;
+    isDirty = false;
+    isValid = true;
+    writeCount++;
+    return true;
+}
+
+template <class T>
+void WriteCoalescer<T>::invalidate(void)
+{
+    std::lock_guard<std::mutex> lock(dataMutex);
+    isValid = false;
+}
+
+template <class T>
+bool WriteCoalescer<T>::isChanged(const T& data) const
+{
+    double newFields[NumberOfFields];
+    double lastFields[NumberOfFields];
+    memcpy(newFields, &data, sizeof(T));
+    memcpy(lastFields, &lastWritten, sizeof(T));
+    for (size_t index = 0; index < NumberOfFields; index++)
+    {
+        if (fabs(newFields[index] - lastFields[index]) > deadband)
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#include "AircraftProfile.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    const AircraftParameters BenchParameters{ 2, 4, 150 };
+}
+
+// aircraft change: the first getProfile of a title; argument 1 = the profile file exists, 0 = defaults only
+static void BM_ProfileCacheCold(benchmark::State& state)
+{
+    const std::string Title = "Bench Aircraft";
+    const std::string FileName = "profiles/Bench_Aircraft.txt";
+    if (state.range(0))
+    {
+        std::filesystem::create_directories("profiles");
+        std::ofstream(FileName) << "force_gain 0 0 120 1 180 1.4 300 1.4\nyoke_x_curve -1 -1 -0.2 -0.1 0.2 0.1 1 1\nflaps_detents 0 0.1 0.3 0.6 1\n";
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ProfileCache* pCache = new ProfileCache;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(pCache->getProfile(Title, BenchParameters));
+        state.PauseTiming();
+        delete pCache;
+        state.ResumeTiming();
+    }
+    if (state.range(0))
+    {
+        std::filesystem::remove(FileName);
+        std::filesystem::remove("profiles");    // only when empty
+    }
+}
+BENCHMARK(BM_ProfileCacheCold)->Arg(0)->Arg(1)->Iterations(200);
+
+// every simulator frame: the profile of the current title from the cache
+static void BM_ProfileCacheCached(benchmark::State& state)
+{
+    ProfileCache cache;
+    cache.getProfile("Bench Aircraft", BenchParameters);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache.getProfile("Bench Aircraft", BenchParameters));
+    }
+}
+BENCHMARK(BM_ProfileCacheCached);
+
+// table lookups of one simulator frame
+static void BM_ProfileFrameLookups(benchmark::State& state)
+{
+    AircraftProfile profile;
+    profile.computeDefault(BenchParameters);
+    double airspeed = 0;
+    for (auto _ : state)
+    {
+        airspeed = airspeed > 250 ? 0 : airspeed + 0.7;
+        benchmark::DoNotOptimize(profile.getForceGain(airspeed));
+        benchmark::DoNotOptimize(profile.getFlapsLeverPosition(2));
+    }
+}
+BENCHMARK(BM_ProfileFrameLookups);
@@ -0,0 +1,36 @@
+#include "AllocationCount.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{ 0 };
+}
+
+uint64_t getAllocationCount(void)
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+// every allocation of the benchmark binary is counted for the allocation counters of the benchmarks
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pMemory = malloc(size ? size : 1);
+    if (!pMemory)
+    {
+        throw std::bad_alloc();
+    }
+    return pMemory;
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+    operator delete(pMemory);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <cstdint>
+
+uint64_t getAllocationCount(void);      // allocations of the benchmark binary since its start
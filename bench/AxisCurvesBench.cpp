@@ -0,0 +1,27 @@
+#include "AxisCurves.h"
+#include <benchmark/benchmark.h>
+
+// all axes of one joystick report through the lookup tables
+static void BM_AxisCurvesEvaluate(benchmark::State& state)
+{
+    AxisCurves curves;
+    AxisCurveConfig config;
+    config.deadzone = 0.05f;
+    config.expo = 0.4f;
+    config.detents = { 0.5f };
+    config.detentWidth = 0.02f;
+    for (int axis = 0; axis < AxisCurves::NumberOfAxes; axis++)
+    {
+        curves.configure(static_cast<AxisCurves::Axis>(axis), config);
+    }
+    float inputs[AxisCurves::NumberOfAxes] = { -0.3f, 0.1f, 0.2f, 0.3f, 0.4f };
+    float outputs[AxisCurves::NumberOfAxes];
+    for (auto _ : state)
+    {
+        inputs[0] = inputs[0] > 0.9f ? -0.9f : inputs[0] + 0.001f;
+        benchmark::DoNotOptimize(inputs);
+        curves.evaluate(inputs, outputs);
+        benchmark::DoNotOptimize(outputs);
+    }
+}
+BENCHMARK(BM_AxisCurvesEvaluate);
@@ -0,0 +1,31 @@
+#include "Profiler.h"
+#include <benchmark/benchmark.h>
+
+// one time stamp of a zone
+static void BM_ProfilerTicks(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Profiler::getTicks());
+    }
+}
+BENCHMARK(BM_ProfilerTicks);
+
+// an empty zone; argument 1 = capture running, 0 = capture stopped
+static void BM_ProfileZone(benchmark::State& state)
+{
+    if (state.range(0))
+    {
+        Profiler::getInstance().start();
+    }
+    for (auto _ : state)
+    {
+        PROFILE_ZONE("BM_ProfileZone");
+        benchmark::ClobberMemory();
+    }
+    if (state.range(0))
+    {
+        Profiler::getInstance().cancel();
+    }
+}
+BENCHMARK(BM_ProfileZone)->Arg(0)->Arg(1);
@@ -0,0 +1,87 @@
+#include "ReportLayout.h"
+#include "ReportFixtures.h"
+#include "Convert.h"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // standard stick: 16-bit X, 8-bit throttle and 8 buttons after the report ID
+    ReportLayout makeStandardLayout(void)
+    {
+        ReportLayout layout;
+        layout.addValueField({ ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 16, -32767, 32767 });
+        layout.addValueField({ ReportLayout::SimulationPage, ReportLayout::UsageThrottle, 24, 8, 0, 255 });
+        for (uint16_t button = 1; button <= 8; button++)
+        {
+            layout.addButton(button, static_cast<uint16_t>(31 + button));
+        }
+        return layout;
+    }
+}
+
+// fields discovered from the report descriptor
+static void BM_ReportLayoutParse(benchmark::State& state)
+{
+    ReportLayout layout = makeStandardLayout();
+    uint8_t report[] = { 0x02, 0x34, 0x12, 0x80, 0x05 };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(report);
+        float x = layout.getBipolar(report, sizeof(report), 0);
+        float throttle = layout.getUnipolar(report, sizeof(report), 1);
+        uint32_t buttons = layout.getButtons(report, sizeof(report));
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(throttle);
+        benchmark::DoNotOptimize(buttons);
+    }
+}
+BENCHMARK(BM_ReportLayoutParse);
+
+// vendor defined report with fixed offsets
+static void BM_VendorReportParse(benchmark::State& state)
+{
+    uint8_t report[64] = { 0x02 };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(report);
+        uint8_t* pData = &report[1];
+        float x = parseData<float>(pData);
+        float throttle = parseData<float>(pData);
+        uint32_t buttons = parseData<uint32_t>(pData);
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(throttle);
+        benchmark::DoNotOptimize(buttons);
+    }
+}
+BENCHMARK(BM_VendorReportParse);
+
+static void BM_ExtractField(benchmark::State& state)
+{
+    uint8_t report[16] = { 0x02, 0x34, 0x12, 0x80, 0x05 };
+    uint16_t bitOffset = static_cast<uint16_t>(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(report);
+        benchmark::DoNotOptimize(ReportLayout::extract(report, sizeof(report), bitOffset, 12, true));
+    }
+}
+BENCHMARK(BM_ExtractField)->Arg(8)->Arg(13);
+
+// all fields and buttons of the report of a typical device
+static void BM_FixtureExtraction(benchmark::State& state)
+{
+    const ReportFixture& fixture = getReportFixtures()[static_cast<size_t>(state.range(0))];
+    ReportLayout layout = fixture.makeLayout();
+    std::vector<uint8_t> report = fixture.report;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(report.data());
+        for (size_t index = 0; index < layout.getNumberOfValueFields(); index++)
+        {
+            benchmark::DoNotOptimize(layout.getUnipolar(report.data(), report.size(), static_cast<int>(index)));
+        }
+        benchmark::DoNotOptimize(layout.getButtons(report.data(), report.size()));
+    }
+    state.SetLabel(fixture.name);
+}
+BENCHMARK(BM_FixtureExtraction)->DenseRange(0, 2);
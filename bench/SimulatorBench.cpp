@@ -0,0 +1,305 @@
+#include "Simulator.h"
+#include "Arbiter.h"
+#include "Convert.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include "AllocationCount.h"
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+
+namespace
+{
+    // the client connected to the stand-in server and serviced by the benchmark itself
+    class ConnectedSimulator
+    {
+    public:
+        ConnectedSimulator(StandInJoystick::Format format) :
+            joystick(format)
+        {
+            server.reset();
+            initializeStandInFlight(server);
+            Simulator::getInstance().setJoystickLink(&joystick);
+            joystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (!server.isConnected() && (std::chrono::steady_clock::now() < deadline))
+            {
+                Simulator::getInstance().service();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        ~ConnectedSimulator()
+        {
+            Simulator::getInstance().shutdown();
+            Simulator::getInstance().setJoystickLink(nullptr);
+        }
+        SimConnectStandIn& server{ SimConnectStandIn::getInstance() };
+        StandInJoystick joystick;
+    };
+}
+
+// joystick report to the coalesced simulator write
+static void BM_JoystickReport(benchmark::State& state)
+{
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    float position = 0;
+    for (auto _ : state)
+    {
+        position = position > 0.9f ? -0.9f : position + 0.001f;
+        simulator.joystick.setInputs(position, 0.5f, 0);
+        simulator.joystick.sendReport();
+    }
+}
+BENCHMARK(BM_JoystickReport);
+
+// one simulator frame: queuing in the server, dispatch, processing and flush of the joystick data
+static void BM_SimulatorFrame(benchmark::State& state)
+{
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    double time = 0;
+    for (auto _ : state)
+    {
+        time += 1.0 / SimConnectStandIn::FramesPerSecond;
+        updateStandInFlight(time, simulator.server, simulator.joystick);
+        simulator.server.runFrame();
+        Simulator::getInstance().service();
+    }
+}
+BENCHMARK(BM_SimulatorFrame);
+
+// SetData calls per second of simulator time with a 1 kHz joystick; argument 1 = coalesced writes, 0 = write per report
+static void BM_SetDataCalls(benchmark::State& state)
+{
+    const SIMCONNECT_DATA_DEFINITION_ID WriteDefinition = 2;    // SimDataWriteDefinition of the client
+    const int ReportsPerFrame = 1000 / SimConnectStandIn::FramesPerSecond;
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    Simulator::getInstance().setWriteCoalescing(state.range(0) != 0);
+    Simulator::getInstance().service();     // subscriptions of the connection setup; the first frame brings the 1 Hz replies too
+    uint32_t setDataCount = simulator.server.getSetDataCount(WriteDefinition);
+    uint32_t flushCount = Simulator::getInstance().getFlushCount();
+    float position = 0;
+    for (auto _ : state)
+    {
+        for (int report = 0; report < ReportsPerFrame; report++)
+        {
+            position = position > 0.9f ? -0.9f : position + 0.001f;
+            simulator.joystick.setInputs(position, 0.5f, 0);
+            simulator.joystick.sendReport();
+        }
+        simulator.server.runFrame();
+        Simulator::getInstance().service();
+    }
+    double simulatorTime = static_cast<double>(state.iterations()) / SimConnectStandIn::FramesPerSecond;    // [s]
+    state.counters["SetData/s"] = (simulator.server.getSetDataCount(WriteDefinition) - setDataCount) / simulatorTime;
+    // the 1 Hz test and aircraft requests are active; only the per-frame data flushes the writes
+    uint32_t flushes = Simulator::getInstance().getFlushCount() - flushCount;
+    uint32_t setDataCalls = simulator.server.getSetDataCount(WriteDefinition) - setDataCount;
+    if ((flushes != state.iterations()) || ((state.range(0) != 0) && (setDataCalls > state.iterations())))
+    {
+        state.SkipWithError("more than one flush or coalesced write per simulator frame");
+    }
+    Simulator::getInstance().setWriteCoalescing(true);
+}
+BENCHMARK(BM_SetDataCalls)->Arg(1)->Arg(0);
+
+// frame-to-dispatch latency and idle CPU load of the simulator thread; argument 1 = event driven dispatch, 0 = polling
+static void BM_DispatchMode(benchmark::State& state)
+{
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    Simulator::getInstance().setEventDrivenDispatch(state.range(0) != 0);
+    Simulator::getInstance().service();     // messages of the connection setup are not measured
+    simulator.server.getDispatchLatency().reset();
+    std::atomic<bool> stopRequest{ false };
+    std::thread simulatorThread([&stopRequest]()
+        {
+            while (!stopRequest)
+            {
+                Simulator::getInstance().service();
+                Simulator::getInstance().waitForService();
+            }
+        });
+    const auto FramePeriod = std::chrono::microseconds(1000000 / SimConnectStandIn::FramesPerSecond);
+    double time = 0;
+    for (auto _ : state)
+    {
+        time += 1.0 / SimConnectStandIn::FramesPerSecond;
+        updateStandInFlight(time, simulator.server, simulator.joystick);
+        simulator.server.runFrame();
+        std::this_thread::sleep_for(FramePeriod);
+    }
+    state.counters["latency[us]"] = static_cast<double>(simulator.server.getDispatchLatency().getAverage());
+
+    // no simulator frames: the thread only sends joystick feedback (and polls the server in polling mode)
+    const auto IdleTime = std::chrono::milliseconds(250);
+    std::clock_t cpuStartTime = std::clock();
+    std::this_thread::sleep_for(IdleTime);
+    double cpuTime = static_cast<double>(std::clock() - cpuStartTime) / CLOCKS_PER_SEC;    // [s]
+    state.counters["idle CPU[%]"] = 100.0 * cpuTime / std::chrono::duration<double>(IdleTime).count();
+
+    stopRequest = true;
+    Simulator::getInstance().getWakeupEvent().set();
+    simulatorThread.join();
+    Simulator::getInstance().setEventDrivenDispatch(true);
+}
+BENCHMARK(BM_DispatchMode)->Arg(1)->Arg(0)->Iterations(30);
+
+// the client loop of both execution models at 60 Hz simulator frames and 250 Hz joystick reports
+// argument 1 = reactor (one thread services both links), 0 = threaded (a thread per link)
+static void BM_ExecutionModel(benchmark::State& state)
+{
+    const bool reactorMode = state.range(0) != 0;
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    Simulator::getInstance().service();     // messages of the connection setup are not measured
+    simulator.server.getDispatchLatency().reset();
+    const auto ReportPeriod = std::chrono::milliseconds(4);
+    std::atomic<bool> stopRequest{ false };
+    std::thread simulatorThread;
+    std::thread joystickThread;
+    if (reactorMode)
+    {
+        simulatorThread = std::thread([&]()
+            {
+                Event* events[] = { &Simulator::getInstance().getSimConnectEvent(), &Simulator::getInstance().getWakeupEvent() };
+                auto nextReportTime = std::chrono::steady_clock::now() + ReportPeriod;
+                while (!stopRequest)
+                {
+                    auto now = std::chrono::steady_clock::now();
+                    if (now >= nextReportTime)
+                    {
+                        simulator.joystick.sendReport();
+                        nextReportTime += ReportPeriod;
+                    }
+                    else
+                    {
+                        Event::waitAny(events, 2, std::chrono::ceil<std::chrono::milliseconds>(nextReportTime - now));
+                    }
+                    Simulator::getInstance().service();
+                }
+            });
+    }
+    else
+    {
+        simulatorThread = std::thread([&stopRequest]()
+            {
+                while (!stopRequest)
+                {
+                    Simulator::getInstance().service();
+                    Simulator::getInstance().waitForService();
+                }
+            });
+        joystickThread = std::thread([&]()
+            {
+                while (!stopRequest)
+                {
+                    simulator.joystick.sendReport();
+                    std::this_thread::sleep_for(ReportPeriod);
+                }
+            });
+    }
+    const auto FramePeriod = std::chrono::microseconds(1000000 / SimConnectStandIn::FramesPerSecond);
+    double time = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    std::clock_t cpuStartTime = std::clock();
+    for (auto _ : state)
+    {
+        time += 1.0 / SimConnectStandIn::FramesPerSecond;
+        updateStandInFlight(time, simulator.server, simulator.joystick);
+        simulator.server.runFrame();
+        std::this_thread::sleep_for(FramePeriod);
+    }
+    double cpuTime = static_cast<double>(std::clock() - cpuStartTime) / CLOCKS_PER_SEC;    // [s]
+    double runTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();    // [s]
+    state.counters["latency[us]"] = static_cast<double>(simulator.server.getDispatchLatency().getAverage());
+    state.counters["CPU[%]"] = 100.0 * cpuTime / runTime;
+
+    stopRequest = true;
+    Simulator::getInstance().getWakeupEvent().set();
+    simulatorThread.join();
+    if (joystickThread.joinable())
+    {
+        joystickThread.join();
+    }
+}
+BENCHMARK(BM_ExecutionModel)->Arg(1)->Arg(0)->Iterations(30);
+
+// full traffic sweeps of 500 objects at the 30 Hz request period through the dispatch of the client
+// the time of an iteration is the cost of one sweep: dispatch of its replies, table update and the next request
+static void BM_TrafficSweep(benchmark::State& state)
+{
+    const uint32_t NumberOfObjects = 500;
+    const auto SweepPeriod = std::chrono::milliseconds(34);     // just over the request period of the client
+    ConnectedSimulator simulator(StandInJoystick::Format::Vendor);
+    simulator.server.setNumberOfTrafficObjects(NumberOfObjects);
+    Simulator::getInstance().setTrafficEnabled(true);
+    // the first sweep fills the table
+    for (int sweep = 0; sweep < 2; sweep++)
+    {
+        SessionClock::advance(SweepPeriod);
+        Simulator::getInstance().service();
+    }
+    uint32_t sweepCount = Simulator::getInstance().getTrafficTable().getSweepCount();
+    uint64_t allocationStartCount = getAllocationCount();
+    for (auto _ : state)
+    {
+        SessionClock::advance(SweepPeriod);
+        Simulator::getInstance().service();
+    }
+    uint32_t sweeps = Simulator::getInstance().getTrafficTable().getSweepCount() - sweepCount;
+    if ((sweeps != state.iterations()) || (Simulator::getInstance().getTrafficTable().size() != NumberOfObjects))
+    {
+        state.SkipWithError("incomplete traffic sweeps");
+    }
+    state.counters["objects/sweep"] = static_cast<double>(Simulator::getInstance().getTrafficTable().size());
+    state.counters["allocs/sweep"] = static_cast<double>(getAllocationCount() - allocationStartCount) / state.iterations();
+    Simulator::getInstance().setTrafficEnabled(false);
+    simulator.server.setNumberOfTrafficObjects(0);
+}
+BENCHMARK(BM_TrafficSweep);
+
+static void BM_ThrottleArbitration(benchmark::State& state)
+{
+    Arbiter<float> arbiter;
+    float remote = 0;
+    for (auto _ : state)
+    {
+        remote = remote > 1 ? 0 : remote + 0.01f;
+        benchmark::DoNotOptimize(arbiter.setRequested(remote, 0.5f, 10));
+    }
+}
+BENCHMARK(BM_ThrottleArbitration);
+
+// the fixed-point part of the joystick feedback frame
+static void BM_FeedbackEncoding(benchmark::State& state)
+{
+    uint8_t frame[64];
+    double force = 0.123;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(force);
+        uint8_t* pBuffer = frame;
+        placeFixed<double>(force, Simulator::YokeForceFormat, pBuffer);
+        placeFixed<double>(0.75, Simulator::ThrottleLeverFormat, pBuffer);
+        placeFixed<float>(1.5f, Simulator::ForceGainFormat, pBuffer);
+        placeFixed<float>(0.25f, Simulator::FlapsLeverFormat, pBuffer);
+        benchmark::DoNotOptimize(frame);
+    }
+}
+BENCHMARK(BM_FeedbackEncoding);
+
+// the whole joystick feedback frame
+static void BM_FeedbackPacking(benchmark::State& state)
+{
+    uint8_t frame[64];
+    Simulator::FeedbackData data{ 3, 1, 0.123, 0x03, 0.75, 1.5f, 0.25f };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(data);
+        benchmark::DoNotOptimize(Simulator::packFeedback(data, frame));
+        benchmark::DoNotOptimize(frame);
+    }
+}
+BENCHMARK(BM_FeedbackPacking);
@@ -0,0 +1,216 @@
+// MsSimConnectSoak.cpp : accelerated long session of the client against the stand-in transports.
+// The session clock is advanced by one simulator frame per iteration, so 24 h of session run in a few minutes.
+// Resident memory, allocations, frame latency and queue depths are tracked and checked against pass/fail thresholds.
+
+#include "Simulator.h"
+#include "HealthMonitor.h"
+#include "Platform.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cmath>
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount{ 0 };
+    std::atomic<uint64_t> releaseCount{ 0 };
+}
+
+// every allocation of the process is counted; live allocations = allocations - releases
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pMemory = malloc(size ? size : 1);
+    if (!pMemory)
+    {
+        throw std::bad_alloc();
+    }
+    return pMemory;
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    if (pMemory)
+    {
+        releaseCount.fetch_add(1, std::memory_order_relaxed);
+        free(pMemory);
+    }
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+    operator delete(pMemory);
+}
+
+namespace
+{
+    // histogram of frame processing times with 1 us bins
+    class LatencyHistogram
+    {
+    public:
+        void addSample(std::chrono::steady_clock::duration latency)
+        {
+            auto latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+            bins[latencyUs < static_cast<int64_t>(NumberOfBins - 1) ? static_cast<size_t>(latencyUs < 0 ? 0 : latencyUs) : NumberOfBins - 1]++;
+            sampleCount++;
+            maxUs = latencyUs > maxUs ? latencyUs : maxUs;
+        }
+        int64_t getPercentile(double percent) const     // upper limit of the bin [us]
+        {
+            uint64_t threshold = static_cast<uint64_t>(ceil(sampleCount * percent / 100));
+            uint64_t count = 0;
+            for (size_t bin = 0; bin < NumberOfBins; bin++)
+            {
+                count += bins[bin];
+                if (count >= threshold)
+                {
+                    return static_cast<int64_t>(bin + 1);
+                }
+            }
+            return maxUs;
+        }
+        int64_t getMax(void) const { return maxUs; }
+    private:
+        static const size_t NumberOfBins = 10000;
+        std::vector<uint64_t> bins = std::vector<uint64_t>(NumberOfBins, 0);
+        uint64_t sampleCount{ 0 };
+        int64_t maxUs{ 0 };
+    };
+
+    struct Thresholds
+    {
+        size_t memoryGrowth{ 4096 };        // resident memory after the warm-up [kB]
+        int64_t liveAllocationGrowth{ 256 };    // allocations not released after the warm-up
+        int64_t frameLatencyP99{ 1000 };    // [us]
+        size_t queueDepth{ 128 };           // messages waiting for dispatch at the start of a frame (traffic replies included)
+        uint32_t droppedMessages{ 0 };
+    };
+
+    const char* AircraftTitles[] = { "Stand-in Trainer", "Stand-in Twin", "Stand-in Jet", "Stand-in Glider", "Stand-in Taildragger" };
+}
+
+int main(int argc, char* argv[])
+{
+    int hours = 24;     // length of the session [h]
+    for (int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        std::string argument(argv[argIndex]);
+        if (argument.rfind("--hours=", 0) == 0)
+        {
+            hours = atoi(argument.c_str() + 8);
+        }
+        else
+        {
+            std::cout << "unknown option: " << argument << std::endl;
+        }
+    }
+
+    SimConnectStandIn& server = SimConnectStandIn::getInstance();
+    StandInJoystick joystick(StandInJoystick::Format::Vendor);
+    Simulator::getInstance().setJoystickLink(&joystick);
+    Simulator::getInstance().setTrafficEnabled(true);
+    joystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+    initializeStandInFlight(server);
+
+    const auto FramePeriod = std::chrono::steady_clock::duration(std::chrono::seconds(1)) / SimConnectStandIn::FramesPerSecond;
+    const uint64_t FramesPerHour = 3600ULL * SimConnectStandIn::FramesPerSecond;
+    const uint64_t TotalFrames = FramesPerHour * (hours > 0 ? hours : 1);
+    const uint64_t WarmupFrames = (std::min)(FramesPerHour, TotalFrames / 4);
+    const double ReportsPerFrame = 250.0 / SimConnectStandIn::FramesPerSecond;     // joystick report rate 250 Hz
+    Thresholds thresholds;
+
+    LatencyHistogram frameLatency;
+    size_t maxQueueDepth = 0;
+    size_t baselineMemory = 0;
+    int64_t baselineLiveAllocations = 0;
+    double reportCredit = 0;
+    uint32_t serverQuitCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    std::cout << "soak run of " << hours << " h session" << std::endl;
+    std::cout << std::setw(6) << "hour" << std::setw(12) << "memory[kB]" << std::setw(14) << "live allocs" << std::setw(14) << "allocs/frame"
+        << std::setw(10) << "p99[us]" << std::setw(10) << "max[us]" << std::setw(8) << "queue" << std::endl;
+    uint64_t lastAllocationCount = allocationCount;
+
+    for (uint64_t frame = 1; frame <= TotalFrames; frame++)
+    {
+        SessionClock::advance(FramePeriod);
+        double time = static_cast<double>(frame) / SimConnectStandIn::FramesPerSecond;     // session time [s]
+        uint64_t frameOfHour = frame % FramesPerHour;
+
+        // session events: simulator restart every 2 h, joystick unplugged for 5 s every hour, aircraft change every 20 min
+        if ((frame % (2 * FramesPerHour)) == FramesPerHour / 4)
+        {
+            server.quit();
+            serverQuitCount++;
+        }
+        joystick.setConnected((frameOfHour < FramesPerHour / 2) || (frameOfHour >= FramesPerHour / 2 + 5 * SimConnectStandIn::FramesPerSecond));
+        if ((frame % (FramesPerHour / 3)) == 0)
+        {
+            server.setTitle(AircraftTitles[(frame / (FramesPerHour / 3)) % (sizeof(AircraftTitles) / sizeof(AircraftTitles[0]))]);
+        }
+        server.setNumberOfTrafficObjects(static_cast<uint32_t>(20 + 20 * sin(time / 600)));
+        updateStandInFlight(time, server, joystick);
+
+        auto frameStartTime = std::chrono::steady_clock::now();
+        server.runFrame();
+        maxQueueDepth = (std::max)(maxQueueDepth, server.getQueueDepth());
+        for (reportCredit += ReportsPerFrame; reportCredit >= 1; reportCredit--)
+        {
+            if (joystick.isConnectionOpen())
+            {
+                joystick.sendReport();
+            }
+        }
+        Simulator::getInstance().service();
+        frameLatency.addSample(std::chrono::steady_clock::now() - frameStartTime);
+
+        if (frame == WarmupFrames)
+        {
+            baselineMemory = getPrivateMemorySize();
+            baselineLiveAllocations = static_cast<int64_t>(allocationCount - releaseCount);
+        }
+        if ((frame % FramesPerHour) == 0)
+        {
+            uint64_t allocations = allocationCount;
+            std::cout << std::setw(6) << frame / FramesPerHour << std::setw(12) << getPrivateMemorySize()
+                << std::setw(14) << static_cast<int64_t>(allocations - releaseCount) << std::setw(14) << std::setprecision(3) << static_cast<double>(allocations - lastAllocationCount) / FramesPerHour
+                << std::setw(10) << frameLatency.getPercentile(99) << std::setw(10) << frameLatency.getMax() << std::setw(8) << maxQueueDepth << std::endl;
+            lastAllocationCount = allocations;
+        }
+    }
+    Simulator::getInstance().shutdown();
+
+    // evaluation against the thresholds
+    size_t memoryGrowth = getPrivateMemorySize() - (std::min)(getPrivateMemorySize(), baselineMemory);
+    int64_t liveAllocationGrowth = static_cast<int64_t>(allocationCount - releaseCount) - baselineLiveAllocations;
+    bool isPassed = true;
+    auto check = [&isPassed](std::string name, double value, double limit)
+        {
+            bool isOk = value <= limit;
+            std::cout << std::left << std::setw(28) << name << std::right << std::setw(12) << value << " <= " << std::setw(8) << limit << (isOk ? "   ok" : "   FAILED") << std::endl;
+            isPassed &= isOk;
+        };
+    std::cout << "========== soak results ==========" << std::endl << std::fixed << std::setprecision(1);
+    std::cout << "wall time [s] = " << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << std::endl;
+    std::cout << "simulator frames = " << TotalFrames << ", joystick reports = " << joystick.getReportCount() << ", feedback frames = " << joystick.getFeedbackCount() << std::endl;
+    std::cout << "simulator restarts = " << serverQuitCount << ", frame latency p50/p99/p99.9 [us] = " << frameLatency.getPercentile(50) << "/" << frameLatency.getPercentile(99) << "/" << frameLatency.getPercentile(99.9) << std::endl;
+    check("memory growth [kB]", static_cast<double>(memoryGrowth), static_cast<double>(thresholds.memoryGrowth));
+    check("live allocation growth", static_cast<double>(liveAllocationGrowth), static_cast<double>(thresholds.liveAllocationGrowth));
+    check("frame latency p99 [us]", static_cast<double>(frameLatency.getPercentile(99)), static_cast<double>(thresholds.frameLatencyP99));
+    check("max queue depth", static_cast<double>(maxQueueDepth), static_cast<double>(thresholds.queueDepth));
+    check("dropped messages", server.getDroppedCount(), thresholds.droppedMessages);
+    check("growing health gauges", static_cast<double>(HealthMonitor::getInstance().getGrowingGauges().size()), 0);
+    // the feedback period is 20 ms, i.e. every second frame at 60 Hz, minus the time without the simulator
+    check("missing feedback frames [%]", 100.0 - 100.0 * joystick.getFeedbackCount() / (TotalFrames / 2.0), 5);
+    std::cout << (isPassed ? "PASSED" : "FAILED") << std::endl;
+    return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,92 @@
+#include "ReportFixtures.h"
+
+ReportLayout ReportFixture::makeLayout(void) const
+{
+    ReportLayout layout;
+    for (auto const& field : valueFields)
+    {
+        layout.addValueField(field);
+    }
+    for (uint8_t button = 1; button <= numberOfButtons; button++)
+    {
+        layout.addButton(button, static_cast<uint16_t>(firstButtonBit + button - 1));
+    }
+    return layout;
+}
+
+const std::vector<ReportFixture>& getReportFixtures(void)
+{
+    static const std::vector<ReportFixture> fixtures
+    {
+        {
+            // byte aligned fields after report ID 2 - the layout of the stand-in joystick
+            "stick 16-bit X, 8-bit throttle",
+            {
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 16, -32767, 32767 },
+                { ReportLayout::SimulationPage, ReportLayout::UsageThrottle, 24, 8, 0, 255 }
+            },
+            32, 8,
+            { 0x02, 0x00, 0xC0, 0x40, 0x81 },
+            { -16384, 64 },
+            0x81,
+            {
+                0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,     // generic desktop, joystick, application collection
+                0x85, 0x02,                             // report ID 2
+                0x09, 0x30, 0x16, 0x01, 0x80, 0x26, 0xFF, 0x7F, 0x75, 0x10, 0x95, 0x01, 0x81, 0x02,     // X -32767..32767, 16 bits
+                0x05, 0x02, 0x09, 0xBB, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,   // simulation throttle 0..255, 8 bits
+                0x05, 0x09, 0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,     // buttons 1..8
+                0x06, 0x00, 0xFF, 0x09, 0x01, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x3F, 0x91, 0x02,     // vendor output report of 63 bytes
+                0xC0
+            }
+        },
+        {
+            // device without report IDs: 10-bit axes and the hat switch share bytes, the throttle is on the slider
+            "stick 10-bit X/Y, hat, twist, slider",
+            {
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 10, 0, 1023 },
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageY, 18, 10, 0, 1023 },
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageHatSwitch, 28, 4, 0, 7 },
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageRz, 32, 8, 0, 255 },
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageSlider, 48, 8, 0, 255 }
+            },
+            40, 8,
+            { 0x00, 0x00, 0xB2, 0x34, 0x80, 0x05, 0xC8 },
+            { 512, 300, 3, 128, 200 },
+            0x05,
+            {
+                0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,     // generic desktop, joystick, application collection
+                0x09, 0x01, 0xA1, 0x00,                 // pointer, physical collection
+                0x09, 0x30, 0x09, 0x31, 0x15, 0x00, 0x26, 0xFF, 0x03, 0x75, 0x0A, 0x95, 0x02, 0x81, 0x02,   // X and Y 0..1023, 10 bits
+                0xC0,
+                0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x35, 0x00, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42,   // hat switch 0..7 with null state, 0..315 degrees
+                0x65, 0x00,
+                0x09, 0x35, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,   // Rz (twist) 0..255
+                0x05, 0x09, 0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02,     // buttons 1..8
+                0x05, 0x01, 0x09, 0x36, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,   // slider 0..255
+                0xC0
+            }
+        },
+        {
+            // 12-bit signed axes crossing byte boundaries, 16-bit throttle and 32 buttons after report ID 1
+            "yoke 12-bit X/Y, 16-bit throttle, 32 buttons",
+            {
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 12, -2047, 2047 },
+                { ReportLayout::GenericDesktopPage, ReportLayout::UsageY, 20, 12, -2047, 2047 },
+                { ReportLayout::SimulationPage, ReportLayout::UsageThrottle, 32, 16, 0, 65535 }
+            },
+            48, 32,
+            { 0x01, 0x18, 0xCC, 0x5D, 0x40, 0x9C, 0x01, 0x80, 0x00, 0x80 },
+            { -1000, 1500, 40000 },
+            0x80008001,
+            {
+                0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,     // generic desktop, joystick, application collection
+                0x85, 0x01,                             // report ID 1
+                0x09, 0x30, 0x09, 0x31, 0x16, 0x01, 0xF8, 0x26, 0xFF, 0x07, 0x75, 0x0C, 0x95, 0x02, 0x81, 0x02,     // X and Y -2047..2047, 12 bits
+                0x05, 0x02, 0x09, 0xBB, 0x15, 0x00, 0x27, 0xFF, 0xFF, 0x00, 0x00, 0x75, 0x10, 0x95, 0x01, 0x81, 0x02,   // simulation throttle 0..65535, 16 bits
+                0x05, 0x09, 0x19, 0x01, 0x29, 0x20, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x20, 0x81, 0x02,     // buttons 1..32
+                0xC0
+            }
+        }
+    };
+    return fixtures;
+}
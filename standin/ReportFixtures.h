@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ReportLayout.h"
+#include <cstdint>
+#include <vector>
+
+// input report layouts of typical devices as found by the descriptor probing of the USB link,
+// each with the report descriptor of the device, a captured report and the values it carries
+struct ReportFixture
+{
+    const char* name;
+    std::vector<ReportField> valueFields;
+    uint16_t firstButtonBit;        // buttons 1..numberOfButtons occupy consecutive bits from here
+    uint8_t numberOfButtons;
+    std::vector<uint8_t> report;
+    std::vector<int32_t> values;    // logical value of every value field in the report
+    uint32_t buttons;               // buttons pressed in the report
+    std::vector<uint8_t> descriptor;    // HID report descriptor of the device
+    ReportLayout makeLayout(void) const;
+};
+
+const std::vector<ReportFixture>& getReportFixtures(void);
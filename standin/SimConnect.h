@@ -0,0 +1,157 @@
+#pragma once
+
+// stand-in for the SimConnect client API of the MSFS SDK
+// declares the subset used by the client with the SDK names and message layouts; the server side is SimConnectStandIn
+
+#include "Platform.h"
+#include <cstdint>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+typedef uint32_t DWORD;
+typedef int32_t HRESULT;
+typedef int BOOL;
+typedef void* HANDLE;
+typedef void* HWND;
+typedef const char* LPCSTR;
+#define S_OK ((HRESULT)0)
+#define E_FAIL ((HRESULT)0x80004005u)
+#define CALLBACK
+#endif
+
+typedef DWORD SIMCONNECT_OBJECT_ID;
+typedef DWORD SIMCONNECT_CLIENT_EVENT_ID;
+typedef DWORD SIMCONNECT_NOTIFICATION_GROUP_ID;
+typedef DWORD SIMCONNECT_DATA_DEFINITION_ID;
+typedef DWORD SIMCONNECT_DATA_REQUEST_ID;
+typedef DWORD SIMCONNECT_DATA_REQUEST_FLAG;
+typedef DWORD SIMCONNECT_DATA_SET_FLAG;
+typedef DWORD SIMCONNECT_EVENT_FLAG;
+
+static const DWORD SIMCONNECT_UNUSED = 0xFFFFFFFF;
+static const SIMCONNECT_OBJECT_ID SIMCONNECT_OBJECT_ID_USER = 0;
+static const DWORD SIMCONNECT_GROUP_PRIORITY_HIGHEST = 1;
+static const SIMCONNECT_EVENT_FLAG SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY = 0x00000010;
+static const SIMCONNECT_DATA_REQUEST_FLAG SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT = 0x00000000;
+static const SIMCONNECT_DATA_REQUEST_FLAG SIMCONNECT_DATA_REQUEST_FLAG_CHANGED = 0x00000001;
+static const SIMCONNECT_DATA_REQUEST_FLAG SIMCONNECT_DATA_REQUEST_FLAG_TAGGED = 0x00000002;
+
+enum SIMCONNECT_RECV_ID
+{
+    SIMCONNECT_RECV_ID_NULL,
+    SIMCONNECT_RECV_ID_EXCEPTION,
+    SIMCONNECT_RECV_ID_OPEN,
+    SIMCONNECT_RECV_ID_QUIT,
+    SIMCONNECT_RECV_ID_EVENT,
+    SIMCONNECT_RECV_ID_EVENT_OBJECT_ADDREMOVE,
+    SIMCONNECT_RECV_ID_EVENT_FILENAME,
+    SIMCONNECT_RECV_ID_EVENT_FRAME,
+    SIMCONNECT_RECV_ID_SIMOBJECT_DATA,
+    SIMCONNECT_RECV_ID_SIMOBJECT_DATA_BYTYPE
+};
+
+enum SIMCONNECT_DATATYPE
+{
+    SIMCONNECT_DATATYPE_INVALID,
+    SIMCONNECT_DATATYPE_INT32,
+    SIMCONNECT_DATATYPE_INT64,
+    SIMCONNECT_DATATYPE_FLOAT32,
+    SIMCONNECT_DATATYPE_FLOAT64,
+    SIMCONNECT_DATATYPE_STRING8,
+    SIMCONNECT_DATATYPE_STRING32,
+    SIMCONNECT_DATATYPE_STRING64,
+    SIMCONNECT_DATATYPE_STRING128,
+    SIMCONNECT_DATATYPE_STRING256,
+    SIMCONNECT_DATATYPE_STRING260
+};
+
+enum SIMCONNECT_PERIOD
+{
+    SIMCONNECT_PERIOD_NEVER,
+    SIMCONNECT_PERIOD_ONCE,
+    SIMCONNECT_PERIOD_VISUAL_FRAME,
+    SIMCONNECT_PERIOD_SIM_FRAME,
+    SIMCONNECT_PERIOD_SECOND
+};
+
+enum SIMCONNECT_SIMOBJECT_TYPE
+{
+    SIMCONNECT_SIMOBJECT_TYPE_USER,
+    SIMCONNECT_SIMOBJECT_TYPE_ALL,
+    SIMCONNECT_SIMOBJECT_TYPE_AIRCRAFT,
+    SIMCONNECT_SIMOBJECT_TYPE_HELICOPTER,
+    SIMCONNECT_SIMOBJECT_TYPE_BOAT,
+    SIMCONNECT_SIMOBJECT_TYPE_GROUND
+};
+
+#pragma pack(push, 1)
+
+struct SIMCONNECT_RECV
+{
+    DWORD dwSize;       // record size
+    DWORD dwVersion;    // interface version
+    DWORD dwID;         // SIMCONNECT_RECV_ID
+};
+
+struct SIMCONNECT_RECV_EXCEPTION : public SIMCONNECT_RECV
+{
+    DWORD dwException;
+    DWORD dwSendID;
+    DWORD dwIndex;
+};
+
+struct SIMCONNECT_RECV_OPEN : public SIMCONNECT_RECV
+{
+    char szApplicationName[256];
+    DWORD dwApplicationVersionMajor;
+    DWORD dwApplicationVersionMinor;
+    DWORD dwApplicationBuildMajor;
+    DWORD dwApplicationBuildMinor;
+    DWORD dwSimConnectVersionMajor;
+    DWORD dwSimConnectVersionMinor;
+    DWORD dwSimConnectBuildMajor;
+    DWORD dwSimConnectBuildMinor;
+    DWORD dwReserved1;
+    DWORD dwReserved2;
+};
+
+struct SIMCONNECT_RECV_QUIT : public SIMCONNECT_RECV
+{
+};
+
+struct SIMCONNECT_RECV_SIMOBJECT_DATA : public SIMCONNECT_RECV
+{
+    DWORD dwRequestID;
+    DWORD dwObjectID;
+    DWORD dwDefineID;
+    DWORD dwFlags;
+    DWORD dwentrynumber;    // index of this object in the reply, 1..dwoutof
+    DWORD dwoutof;          // number of objects in the reply
+    DWORD dwDefineCount;    // number of datums
+    DWORD dwData;           // first 4 bytes of the data
+};
+
+struct SIMCONNECT_RECV_SIMOBJECT_DATA_BYTYPE : public SIMCONNECT_RECV_SIMOBJECT_DATA
+{
+};
+
+#pragma pack(pop)
+
+typedef void (CALLBACK* DispatchProc)(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext);
+
+// the event is the native handle of the platform event (eventfd descriptor outside Win32)
+HRESULT SimConnect_Open(HANDLE* phSimConnect, LPCSTR szName, HWND hWnd, DWORD UserEventWin32, Event::NativeHandle hEventHandle, DWORD ConfigIndex);
+HRESULT SimConnect_Close(HANDLE hSimConnect);
+HRESULT SimConnect_CallDispatch(HANDLE hSimConnect, DispatchProc pfcnDispatch, void* pContext);
+HRESULT SimConnect_AddToDataDefinition(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID DefineID, const char* DatumName, const char* UnitsName,
+    SIMCONNECT_DATATYPE DatumType = SIMCONNECT_DATATYPE_FLOAT64, float fEpsilon = 0, DWORD DatumID = SIMCONNECT_UNUSED);
+HRESULT SimConnect_RequestDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_OBJECT_ID ObjectID,
+    SIMCONNECT_PERIOD Period, SIMCONNECT_DATA_REQUEST_FLAG Flags = 0, DWORD origin = 0, DWORD interval = 0, DWORD limit = 0);
+HRESULT SimConnect_RequestDataOnSimObjectType(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, DWORD dwRadiusMeters,
+    SIMCONNECT_SIMOBJECT_TYPE type);
+HRESULT SimConnect_SetDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_OBJECT_ID ObjectID, SIMCONNECT_DATA_SET_FLAG Flags,
+    DWORD ArrayCount, DWORD cbUnitSize, void* pDataSet);
+HRESULT SimConnect_MapClientEventToSimEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID EventID, const char* EventName = "");
+HRESULT SimConnect_TransmitClientEvent(HANDLE hSimConnect, SIMCONNECT_OBJECT_ID ObjectID, SIMCONNECT_CLIENT_EVENT_ID EventID, DWORD dwData,
+    SIMCONNECT_NOTIFICATION_GROUP_ID GroupID, SIMCONNECT_EVENT_FLAG Flags);
@@ -0,0 +1,462 @@
+#include "SimConnectStandIn.h"
+#include <cstring>
+
+SimConnectStandIn& SimConnectStandIn::getInstance()
+{
+    static SimConnectStandIn instance;
+    return instance;
+}
+
+void SimConnectStandIn::setAvailable(bool available)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    this->available = available;
+}
+
+void SimConnectStandIn::setSimVar(std::string name, double value)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    simVars[name] = value;
+}
+
+void SimConnectStandIn::setTitle(std::string title)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    this->title = title;
+}
+
+void SimConnectStandIn::setNumberOfTrafficObjects(uint32_t number)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    numberOfTrafficObjects = number;
+}
+
+// queue the data of every request due in this frame
+void SimConnectStandIn::runFrame(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    frameCount++;
+    if (!connected)
+    {
+        return;
+    }
+    for (auto& request : requests)
+    {
+        bool isDue = false;
+        switch (request.period)
+        {
+        case SIMCONNECT_PERIOD_ONCE:
+            isDue = !request.isSent;
+            break;
+        case SIMCONNECT_PERIOD_VISUAL_FRAME:
+        case SIMCONNECT_PERIOD_SIM_FRAME:
+            isDue = true;
+            break;
+        case SIMCONNECT_PERIOD_SECOND:
+            isDue = !request.isSent || (frameCount % FramesPerSecond == 0);
+            break;
+        default:
+            break;
+        }
+        if (isDue)
+        {
+            request.isSent = true;
+            queueObjectData(SIMCONNECT_RECV_ID_SIMOBJECT_DATA, request, SIMCONNECT_OBJECT_ID_USER, 1, 1, 0);
+        }
+    }
+}
+
+// the server is shutting down
+void SimConnectStandIn::quit(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!connected)
+    {
+        return;
+    }
+    uint8_t* pMessage = allocateMessage(sizeof(SIMCONNECT_RECV_QUIT));
+    if (pMessage)
+    {
+        SIMCONNECT_RECV_QUIT* pQuit = reinterpret_cast<SIMCONNECT_RECV_QUIT*>(pMessage);
+        pQuit->dwSize = sizeof(SIMCONNECT_RECV_QUIT);
+        pQuit->dwVersion = 1;
+        pQuit->dwID = SIMCONNECT_RECV_ID_QUIT;
+        commitMessage();
+    }
+    connected = false;
+}
+
+bool SimConnectStandIn::isConnected(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    return connected;
+}
+
+uint32_t SimConnectStandIn::getFrameCount(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    return frameCount;
+}
+
+uint32_t SimConnectStandIn::getSetDataCount(SIMCONNECT_DATA_DEFINITION_ID defineID)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    auto it = setDataCounts.find(defineID);
+    return it != setDataCounts.end() ? it->second : 0;
+}
+
+bool SimConnectStandIn::getLastSetData(SIMCONNECT_DATA_DEFINITION_ID defineID, std::vector<uint8_t>& data)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    auto it = lastSetData.find(defineID);
+    if (it == lastSetData.end())
+    {
+        return false;
+    }
+    data = it->second;
+    return true;
+}
+
+uint32_t SimConnectStandIn::getTransmitCount(std::string simEventName)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    auto it = transmitCounts.find(simEventName);
+    return it != transmitCounts.end() ? it->second : 0;
+}
+
+size_t SimConnectStandIn::getQueueDepth(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    return queueCount;
+}
+
+uint32_t SimConnectStandIn::getDroppedCount(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    return droppedCount;
+}
+
+void SimConnectStandIn::reset(void)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    clearConnection();
+    available = true;
+    lastTrafficReplyLost = false;
+    frameCount = droppedCount = 0;
+    setDataCounts.clear();
+    lastSetData.clear();
+    transmitCounts.clear();
+    dispatchLatency.reset();
+}
+
+// open a new connection; the previous one is dropped
+HRESULT SimConnectStandIn::open(HANDLE* phSimConnect, Event::NativeHandle eventHandle)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!available)
+    {
+        return E_FAIL;
+    }
+    clearConnection();
+    connected = true;
+    connectionHandle = reinterpret_cast<HANDLE>(++connectionCount);
+    this->eventHandle = eventHandle;
+    *phSimConnect = connectionHandle;
+
+    uint8_t* pMessage = allocateMessage(sizeof(SIMCONNECT_RECV_OPEN));
+    SIMCONNECT_RECV_OPEN* pOpen = reinterpret_cast<SIMCONNECT_RECV_OPEN*>(pMessage);
+    memset(pOpen, 0, sizeof(SIMCONNECT_RECV_OPEN));
+    pOpen->dwSize = sizeof(SIMCONNECT_RECV_OPEN);
+    pOpen->dwVersion = 1;
+    pOpen->dwID = SIMCONNECT_RECV_ID_OPEN;
+    strncpy(pOpen->szApplicationName, "SimConnect stand-in", sizeof(pOpen->szApplicationName) - 1);
+    pOpen->dwSimConnectVersionMajor = 11;
+    pOpen->dwSimConnectVersionMinor = 0;
+    commitMessage();
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::close(HANDLE hSimConnect)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect))
+    {
+        return E_FAIL;
+    }
+    clearConnection();
+    return S_OK;
+}
+
+// dispatch all queued messages; the lock is not held in the callback, so it can call the API again
+HRESULT SimConnectStandIn::callDispatch(HANDLE hSimConnect, DispatchProc pfcnDispatch, void* pContext)
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(serverMutex);
+            if ((hSimConnect != connectionHandle) || (queueCount == 0))
+            {
+                break;
+            }
+            Message& message = queue[queueHead];
+            dispatchMessage.buffer.swap(message.buffer);
+            dispatchMessage.size = message.size;
+            queueHead = (queueHead + 1) % QueueSize;
+            queueCount--;
+            dispatchLatency.addSample(std::chrono::steady_clock::now() - message.queueTime);
+        }
+        pfcnDispatch(reinterpret_cast<SIMCONNECT_RECV*>(dispatchMessage.buffer.data()), dispatchMessage.size, pContext);
+    }
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::addToDataDefinition(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID defineID, const char* datumName, SIMCONNECT_DATATYPE datumType)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect))
+    {
+        return E_FAIL;
+    }
+    Datum datum{ sizeof(double), &simVars[datumName], false };
+    switch (datumType)
+    {
+    case SIMCONNECT_DATATYPE_FLOAT64:
+        break;
+    case SIMCONNECT_DATATYPE_STRING256:
+        datum = { 256, nullptr, true };
+        break;
+    default:
+        // not used by the client
+        return E_FAIL;
+    }
+    definitions[defineID].push_back(datum);
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::requestDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID requestID, SIMCONNECT_DATA_DEFINITION_ID defineID, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect) || (definitions.find(defineID) == definitions.end()))
+    {
+        return E_FAIL;
+    }
+    for (auto& request : requests)
+    {
+        if (request.requestID == requestID)
+        {
+            // the new request replaces the old one with the same ID
+            request = Request{ requestID, defineID, period, flags, false, {} };
+            return S_OK;
+        }
+    }
+    requests.push_back({ requestID, defineID, period, flags, false, {} });
+    return S_OK;
+}
+
+// reply with one message per traffic object; a reply without objects is a single message with dwoutof=0
+HRESULT SimConnectStandIn::requestDataOnSimObjectType(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID requestID, SIMCONNECT_DATA_DEFINITION_ID defineID)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect) || (definitions.find(defineID) == definitions.end()))
+    {
+        return E_FAIL;
+    }
+    Request request{ requestID, defineID, SIMCONNECT_PERIOD_ONCE, SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT, false, {} };
+    if ((numberOfTrafficObjects == 0) && !lastTrafficReplyLost)
+    {
+        queueObjectData(SIMCONNECT_RECV_ID_SIMOBJECT_DATA_BYTYPE, request, 0, 0, 0, 0);
+    }
+    uint32_t numberOfMessages = lastTrafficReplyLost && (numberOfTrafficObjects > 0) ? numberOfTrafficObjects - 1 : numberOfTrafficObjects;
+    for (uint32_t index = 0; index < numberOfMessages; index++)
+    {
+        // every object is placed a bit further from the user aircraft
+        queueObjectData(SIMCONNECT_RECV_ID_SIMOBJECT_DATA_BYTYPE, request, TrafficObjectIDBase + index, index + 1, numberOfTrafficObjects, 0.01 * (index + 1));
+    }
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::setDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID defineID, DWORD cbUnitSize, const void* pDataSet)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect) || (cbUnitSize != getDataSize(defineID)))
+    {
+        return E_FAIL;
+    }
+    setDataCounts[defineID]++;
+    std::vector<uint8_t>& data = lastSetData[defineID];
+    data.resize(cbUnitSize);
+    memcpy(data.data(), pDataSet, cbUnitSize);
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::mapClientEventToSimEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID eventID, const char* eventName)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    if (!isValid(hSimConnect))
+    {
+        return E_FAIL;
+    }
+    clientEvents[eventID] = eventName;
+    return S_OK;
+}
+
+HRESULT SimConnectStandIn::transmitClientEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID eventID)
+{
+    std::lock_guard<std::mutex> lock(serverMutex);
+    auto it = clientEvents.find(eventID);
+    if (!isValid(hSimConnect) || (it == clientEvents.end()))
+    {
+        return E_FAIL;
+    }
+    transmitCounts[it->second]++;
+    return S_OK;
+}
+
+// the caller holds serverMutex
+uint8_t* SimConnectStandIn::allocateMessage(DWORD size)
+{
+    if (queueCount == QueueSize)
+    {
+        droppedCount++;
+        return nullptr;
+    }
+    Message& message = queue[(queueHead + queueCount) % QueueSize];
+    message.buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    message.size = size;
+    return reinterpret_cast<uint8_t*>(message.buffer.data());
+}
+
+// the caller holds serverMutex
+void SimConnectStandIn::commitMessage(void)
+{
+    queue[(queueHead + queueCount) % QueueSize].queueTime = std::chrono::steady_clock::now();
+    queueCount++;
+    Event::signal(eventHandle);
+}
+
+// fill the data block of the request in the order of its datums; the caller holds serverMutex
+bool SimConnectStandIn::queueObjectData(SIMCONNECT_RECV_ID id, const Request& request, DWORD objectID, DWORD entryNumber, DWORD outOf, double offset)
+{
+    const std::vector<Datum>& datums = definitions[request.defineID];
+    const size_t DataOffset = sizeof(SIMCONNECT_RECV_SIMOBJECT_DATA) - sizeof(DWORD);    // data block starts at dwData
+    size_t dataSize = outOf || (id == SIMCONNECT_RECV_ID_SIMOBJECT_DATA) ? getDataSize(request.defineID) : 0;
+    DWORD size = static_cast<DWORD>(DataOffset + (dataSize > sizeof(DWORD) ? dataSize : sizeof(DWORD)));
+    uint8_t* pMessage = allocateMessage(size);
+    if (!pMessage)
+    {
+        return false;
+    }
+    SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = reinterpret_cast<SIMCONNECT_RECV_SIMOBJECT_DATA*>(pMessage);
+    memset(pMessage, 0, size);
+    pObjData->dwSize = size;
+    pObjData->dwVersion = 1;
+    pObjData->dwID = id;
+    pObjData->dwRequestID = request.requestID;
+    pObjData->dwObjectID = objectID;
+    pObjData->dwDefineID = request.defineID;
+    pObjData->dwFlags = request.flags;
+    pObjData->dwentrynumber = entryNumber;
+    pObjData->dwoutof = outOf;
+    pObjData->dwDefineCount = dataSize ? static_cast<DWORD>(datums.size()) : 0;
+
+    uint8_t* pData = pMessage + DataOffset;
+    for (size_t index = 0; dataSize && (index < datums.size()); index++)
+    {
+        if (datums[index].isString)
+        {
+            memcpy(pData, title.c_str(), title.size() < datums[index].size ? title.size() : datums[index].size - 1);
+        }
+        else
+        {
+            double value = *datums[index].pValue + offset;
+            memcpy(pData, &value, sizeof(value));
+        }
+        pData += datums[index].size;
+    }
+
+    if (request.flags & SIMCONNECT_DATA_REQUEST_FLAG_CHANGED)
+    {
+        // sent only when the data differs from the last sent data
+        for (auto& storedRequest : requests)
+        {
+            if (storedRequest.requestID == request.requestID)
+            {
+                if ((storedRequest.lastData.size() == dataSize) && (memcmp(storedRequest.lastData.data(), pMessage + DataOffset, dataSize) == 0))
+                {
+                    return false;
+                }
+                storedRequest.lastData.assign(pMessage + DataOffset, pMessage + DataOffset + dataSize);
+            }
+        }
+    }
+    commitMessage();
+    return true;
+}
+
+// the caller holds serverMutex
+size_t SimConnectStandIn::getDataSize(SIMCONNECT_DATA_DEFINITION_ID defineID)
+{
+    size_t dataSize = 0;
+    for (auto const& datum : definitions[defineID])
+    {
+        dataSize += datum.size;
+    }
+    return dataSize;
+}
+
+// the caller holds serverMutex
+void SimConnectStandIn::clearConnection(void)
+{
+    connected = false;
+    connectionHandle = nullptr;
+    definitions.clear();
+    requests.clear();
+    clientEvents.clear();
+    queueHead = queueCount = 0;
+}
+
+HRESULT SimConnect_Open(HANDLE* phSimConnect, LPCSTR, HWND, DWORD, Event::NativeHandle hEventHandle, DWORD)
+{
+    return SimConnectStandIn::getInstance().open(phSimConnect, hEventHandle);
+}
+
+HRESULT SimConnect_Close(HANDLE hSimConnect)
+{
+    return SimConnectStandIn::getInstance().close(hSimConnect);
+}
+
+HRESULT SimConnect_CallDispatch(HANDLE hSimConnect, DispatchProc pfcnDispatch, void* pContext)
+{
+    return SimConnectStandIn::getInstance().callDispatch(hSimConnect, pfcnDispatch, pContext);
+}
+
+HRESULT SimConnect_AddToDataDefinition(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID DefineID, const char* DatumName, const char*, SIMCONNECT_DATATYPE DatumType, float, DWORD)
+{
+    return SimConnectStandIn::getInstance().addToDataDefinition(hSimConnect, DefineID, DatumName, DatumType);
+}
+
+HRESULT SimConnect_RequestDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_OBJECT_ID,
+    SIMCONNECT_PERIOD Period, SIMCONNECT_DATA_REQUEST_FLAG Flags, DWORD, DWORD, DWORD)
+{
+    return SimConnectStandIn::getInstance().requestDataOnSimObject(hSimConnect, RequestID, DefineID, Period, Flags);
+}
+
+HRESULT SimConnect_RequestDataOnSimObjectType(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID RequestID, SIMCONNECT_DATA_DEFINITION_ID DefineID, DWORD, SIMCONNECT_SIMOBJECT_TYPE)
+{
+    return SimConnectStandIn::getInstance().requestDataOnSimObjectType(hSimConnect, RequestID, DefineID);
+}
+
+HRESULT SimConnect_SetDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID DefineID, SIMCONNECT_OBJECT_ID, SIMCONNECT_DATA_SET_FLAG, DWORD, DWORD cbUnitSize, void* pDataSet)
+{
+    return SimConnectStandIn::getInstance().setDataOnSimObject(hSimConnect, DefineID, cbUnitSize, pDataSet);
+}
+
+HRESULT SimConnect_MapClientEventToSimEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID EventID, const char* EventName)
+{
+    return SimConnectStandIn::getInstance().mapClientEventToSimEvent(hSimConnect, EventID, EventName);
+}
+
+HRESULT SimConnect_TransmitClientEvent(HANDLE hSimConnect, SIMCONNECT_OBJECT_ID, SIMCONNECT_CLIENT_EVENT_ID EventID, DWORD, SIMCONNECT_NOTIFICATION_GROUP_ID, SIMCONNECT_EVENT_FLAG)
+{
+    return SimConnectStandIn::getInstance().transmitClientEvent(hSimConnect, EventID);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "SimConnect.h"
+#include "LatencyStats.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// in-process stand-in of the SimConnect server for the headless build, tests, benchmarks and soak runs
+// it answers the SimConnect API calls of the client, generates the subscribed data of every simulator frame
+// and records everything the client writes; the simulation variables are set by the driver of the run
+class SimConnectStandIn
+{
+public:
+    SimConnectStandIn(SimConnectStandIn const&) = delete;
+    SimConnectStandIn& operator=(SimConnectStandIn const&) = delete;
+    static SimConnectStandIn& getInstance();
+    // server side - called by the driver of the run
+    void setAvailable(bool available);      // a server which is not available refuses connections
+    void setSimVar(std::string name, double value);     // value in the units requested by the client
+    void setTitle(std::string title);
+    void setNumberOfTrafficObjects(uint32_t number);
+    void setLastTrafficReplyLost(bool lost) { lastTrafficReplyLost = lost; }     // the last message of every traffic reply is not sent
+    void runFrame(void);        // generates the data of all subscriptions due in this simulator frame
+    void quit(void);            // the server closes the connection
+    bool isConnected(void);
+    uint32_t getFrameCount(void);
+    uint32_t getSetDataCount(SIMCONNECT_DATA_DEFINITION_ID defineID);     // SetDataOnSimObject calls of the definition
+    bool getLastSetData(SIMCONNECT_DATA_DEFINITION_ID defineID, std::vector<uint8_t>& data);
+    uint32_t getTransmitCount(std::string simEventName);    // transmissions of the mapped simulator event
+    size_t getQueueDepth(void);     // messages waiting for dispatch
+    uint32_t getDroppedCount(void);     // messages dropped when the queue was full
+    LatencyStats& getDispatchLatency(void) { return dispatchLatency; }     // time from queuing of a message to its dispatch
+    void reset(void);       // closes the connection and clears all recorded data
+    // client side - called by the SimConnect API functions
+    HRESULT open(HANDLE* phSimConnect, Event::NativeHandle eventHandle);
+    HRESULT close(HANDLE hSimConnect);
+    HRESULT callDispatch(HANDLE hSimConnect, DispatchProc pfcnDispatch, void* pContext);
+    HRESULT addToDataDefinition(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID defineID, const char* datumName, SIMCONNECT_DATATYPE datumType);
+    HRESULT requestDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID requestID, SIMCONNECT_DATA_DEFINITION_ID defineID, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags);
+    HRESULT requestDataOnSimObjectType(HANDLE hSimConnect, SIMCONNECT_DATA_REQUEST_ID requestID, SIMCONNECT_DATA_DEFINITION_ID defineID);
+    HRESULT setDataOnSimObject(HANDLE hSimConnect, SIMCONNECT_DATA_DEFINITION_ID defineID, DWORD cbUnitSize, const void* pDataSet);
+    HRESULT mapClientEventToSimEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID eventID, const char* eventName);
+    HRESULT transmitClientEvent(HANDLE hSimConnect, SIMCONNECT_CLIENT_EVENT_ID eventID);
+    static const uint32_t FramesPerSecond = 60;
+    static const DWORD TrafficObjectIDBase = 1000;
+private:
+    SimConnectStandIn() {}
+    struct Datum
+    {
+        size_t size;                // bytes in the data block
+        const double* pValue;       // node of simVars; strings are taken from title
+        bool isString;
+    };
+    struct Request
+    {
+        SIMCONNECT_DATA_REQUEST_ID requestID;
+        SIMCONNECT_DATA_DEFINITION_ID defineID;
+        SIMCONNECT_PERIOD period;
+        SIMCONNECT_DATA_REQUEST_FLAG flags;
+        bool isSent{ false };
+        std::vector<uint8_t> lastData;      // for SIMCONNECT_DATA_REQUEST_FLAG_CHANGED
+    };
+    struct Message
+    {
+        std::vector<uint64_t> buffer;       // 8-byte aligned for the doubles of the data block
+        DWORD size{ 0 };
+        std::chrono::steady_clock::time_point queueTime;
+    };
+    bool isValid(HANDLE hSimConnect) const { return connected && (hSimConnect == connectionHandle); }
+    uint8_t* allocateMessage(DWORD size);       // the next free message of the queue or nullptr if the queue is full
+    void commitMessage(void);       // makes the allocated message available for dispatch
+    bool queueObjectData(SIMCONNECT_RECV_ID id, const Request& request, DWORD objectID, DWORD entryNumber, DWORD outOf, double offset);
+    size_t getDataSize(SIMCONNECT_DATA_DEFINITION_ID defineID);
+    void clearConnection(void);
+    std::mutex serverMutex;
+    bool available{ true };
+    bool connected{ false };
+    uintptr_t connectionCount{ 0 };
+    HANDLE connectionHandle{ nullptr };
+    Event::NativeHandle eventHandle{};
+    std::map<std::string, double> simVars;      // node based - datums keep pointers to the values
+    std::string title;
+    uint32_t numberOfTrafficObjects{ 0 };
+    std::atomic<bool> lastTrafficReplyLost{ false };
+    std::map<SIMCONNECT_DATA_DEFINITION_ID, std::vector<Datum>> definitions;
+    std::vector<Request> requests;
+    static const size_t QueueSize = 1024;
+    std::vector<Message> queue{ QueueSize };    // ring of messages; buffers keep their capacity
+    size_t queueHead{ 0 };
+    size_t queueCount{ 0 };
+    Message dispatchMessage;        // message being dispatched (swapped with the queue slot)
+    uint32_t droppedCount{ 0 };
+    uint32_t frameCount{ 0 };
+    std::map<SIMCONNECT_DATA_DEFINITION_ID, uint32_t> setDataCounts;
+    std::map<SIMCONNECT_DATA_DEFINITION_ID, std::vector<uint8_t>> lastSetData;
+    std::map<SIMCONNECT_CLIENT_EVENT_ID, std::string> clientEvents;
+    std::map<std::string, uint32_t> transmitCounts;
+    LatencyStats dispatchLatency;
+};
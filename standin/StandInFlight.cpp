@@ -0,0 +1,26 @@
+#include "StandInFlight.h"
+#include <cmath>
+
+void initializeStandInFlight(SimConnectStandIn& server)
+{
+    server.setTitle("Stand-in Trainer");
+    server.setSimVar("NUMBER OF ENGINES", 1);
+    server.setSimVar("FLAPS NUM HANDLE POSITIONS", 3);
+    server.setSimVar("ESTIMATED CRUISE SPEED", 120);
+}
+
+void updateStandInFlight(double time, SimConnectStandIn& server, StandInJoystick& joystick)
+{
+    double aileron = 0.2 * sin(0.5 * time);
+    server.setSimVar("AILERON POSITION", aileron);
+    server.setSimVar("YOKE X INDICATOR", aileron - 0.02 * sin(11 * time));
+    server.setSimVar("AIRSPEED INDICATED", 110 + 10 * sin(time / 60));
+    server.setSimVar("ROTATION VELOCITY BODY X", 0.05 * sin(0.7 * time));
+    server.setSimVar("ROTATION VELOCITY BODY Y", 0.02 * sin(0.3 * time));
+    server.setSimVar("ROTATION VELOCITY BODY Z", 0.1 * cos(0.5 * time));
+    server.setSimVar("FLAPS HANDLE INDEX", static_cast<double>(static_cast<int>(time / 60) % 4));
+    float throttle = 0.5f + 0.1f * (static_cast<int>(time / 10) % 5);
+    server.setSimVar("GENERAL ENG THROTTLE LEVER POSITION:1", throttle);
+    uint32_t buttons = (static_cast<int>(time / 5) % 2) ? 0x01 : 0x00;
+    joystick.setInputs(static_cast<float>(0.3 * sin(0.5 * time)), throttle, buttons);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+
+// scripted flight for the stand-in transports: slow oscillation of the controls,
+// throttle steps every 10 s and a button toggled every 5 s; time is the flight time [s]
+void updateStandInFlight(double time, SimConnectStandIn& server, StandInJoystick& joystick);
+void initializeStandInFlight(SimConnectStandIn& server);    // aircraft parameters sent on connection
@@ -0,0 +1,119 @@
+#include "StandInJoystick.h"
+#include "Console.h"
+#include "Convert.h"
+#include "FaultInjector.h"
+#include "ReportDescriptor.h"
+#include "ReportFixtures.h"
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+StandInJoystick::StandInJoystick(Format format) :
+    format(format)
+{
+    if (format == Format::Standard)
+    {
+        // layout of a typical stick with the report ID in byte 0, discovered from its report descriptor
+        const ReportFixture& fixture = getReportFixtures().front();
+        ReportDescriptor descriptor;
+        if (descriptor.parse(fixture.descriptor))
+        {
+            descriptor.buildReportLayout(reportLayout, ReportID);
+        }
+    }
+}
+
+// joystick link handler to be called in a separate thread
+void StandInJoystick::handler(void)
+{
+    while (!Console::getInstance().isQuitRequest())
+    {
+        if (isConnectionOpen())
+        {
+            sendReport();
+        }
+        Event* events[] = { &Console::getInstance().getQuitEvent() };
+        Event::waitAny(events, 1, reportPeriod);
+    }
+}
+
+// build the report of the current inputs and pass it to the parse function
+void StandInJoystick::sendReport(void)
+{
+    std::vector<uint8_t> report;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (format == Format::Vendor)
+        {
+            report.resize(ReportSize);
+            uint8_t* pBuffer = report.data();
+            placeData<uint8_t>(ReportID, pBuffer);
+            placeData<float>(yokeX, pBuffer);
+            placeData<float>(throttle, pBuffer);
+            placeData<uint32_t>(buttons, pBuffer);
+            placeData<uint8_t>(VendorReport::ButtonsVersion, pBuffer);
+        }
+        else
+        {
+            report.resize(5);
+            uint8_t* pBuffer = report.data();
+            placeData<uint8_t>(ReportID, pBuffer);
+            placeData<int16_t>(static_cast<int16_t>(lroundf(yokeX * 32767)), pBuffer);
+            placeData<uint8_t>(static_cast<uint8_t>(lroundf(throttle * 255)), pBuffer);
+            placeData<uint8_t>(static_cast<uint8_t>(buttons), pBuffer);
+        }
+    }
+    reportCount++;
+    // the same link faults as in the USB HID transport
+    if (FAULT_ACTIVE(UsbDelayReport))
+    {
+        std::this_thread::sleep_for(FaultInjector::DelayTime);
+    }
+    if (FAULT_ACTIVE(UsbShortReport))
+    {
+        report.resize((std::min)(report.size(), FaultInjector::ShortReportSize));
+    }
+    if (parseCallback && !FAULT_ACTIVE(UsbDropReport))
+    {
+        parseCallback(report);
+    }
+}
+
+void StandInJoystick::setInputs(float yokeX, float throttle, uint32_t buttons)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    this->yokeX = yokeX;
+    this->throttle = throttle;
+    this->buttons = buttons;
+}
+
+void StandInJoystick::setConnected(bool connected)
+{
+    this->connected = connected;
+}
+
+// record the feedback frame; a device which is not connected cannot receive it
+bool StandInJoystick::sendData(uint8_t* dataToSend)
+{
+    if (!isConnectionOpen() || FAULT_ACTIVE(UsbSendError))
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(stateMutex);
+    lastFeedback.assign(dataToSend, dataToSend + ReportSize - 1);
+    feedbackCount++;
+    return true;
+}
+
+uint32_t StandInJoystick::getFeedbackCount(void)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return feedbackCount;
+}
+
+bool StandInJoystick::getLastFeedback(std::vector<uint8_t>& frame)
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    frame = lastFeedback;
+    return feedbackCount > 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "JoystickLink.h"
+#include "Platform.h"
+#include "FaultInjector.h"
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// stand-in of the USB HID joystick for the headless build, tests, benchmarks and soak runs
+// it sends input reports of the configured layout with the inputs set by the driver and records the feedback frames
+class StandInJoystick : public JoystickLink
+{
+public:
+    enum class Format
+    {
+        Vendor,     // report ID + float yoke X + float throttle + uint32 buttons + report version at fixed offsets
+        Standard    // 16-bit X, 8-bit throttle and 8 buttons described by the report layout
+    };
+    StandInJoystick(Format format);
+    void handler(void);     // sends reports periodically until quit is requested
+    void sendReport(void);  // sends one input report with the current inputs
+    void setInputs(float yokeX, float throttle, uint32_t buttons);
+    void setConnected(bool connected);      // the device appears or disappears
+    void setReportPeriod(std::chrono::milliseconds period) { reportPeriod = period; }
+    bool sendData(uint8_t* dataToSend) override;
+    bool isConnectionOpen(void) const override { return connected && !FAULT_ACTIVE(UsbDisconnect); }    // the device disappears during UsbDisconnect
+    const ReportLayout& getReportLayout(void) const override { return reportLayout; }
+    uint32_t getReportLayoutVersion(void) const override { return reportLayoutVersion; }
+    uint32_t getReportCount(void) const { return reportCount; }
+    uint32_t getFeedbackCount(void);
+    bool getLastFeedback(std::vector<uint8_t>& frame);
+    static const size_t ReportSize = 64;    // report ID + 63 bytes of payload
+    static const uint8_t ReportID = 0x02;
+private:
+    Format format;
+    std::atomic<bool> connected{ true };
+    std::chrono::milliseconds reportPeriod{ 4 };     // 250 Hz
+    ReportLayout reportLayout;      // empty for the vendor format
+    uint32_t reportLayoutVersion{ 1 };
+    std::mutex stateMutex;      // inputs and feedback are set and read by the driver thread
+    float yokeX{ 0 };
+    float throttle{ 0 };
+    uint32_t buttons{ 0 };
+    std::atomic<uint32_t> reportCount{ 0 };
+    std::vector<uint8_t> lastFeedback;
+    uint32_t feedbackCount{ 0 };
+};
@@ -0,0 +1,98 @@
+#include "AircraftProfile.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const AircraftParameters TwinParameters{ 2, 4, 150 };
+
+    // profile file in a temporary directory; removed at the end of the test
+    class ProfileFile
+    {
+    public:
+        ProfileFile(std::string content) :
+            fileName((std::filesystem::temp_directory_path() / "mssimconnect_profile_test.txt").string())
+        {
+            std::ofstream(fileName) << content;
+        }
+        ~ProfileFile() { std::filesystem::remove(fileName); }
+        std::string fileName;
+    };
+}
+
+TEST(AircraftProfile, DefaultTablesEndpointsAndClamping)
+{
+    AircraftProfile profile;
+    profile.computeDefault(TwinParameters);
+    EXPECT_EQ(profile.getYokeXCurve(), std::vector<float>({ -1, -1, 1, 1 }));
+    EXPECT_FLOAT_EQ(profile.getForceGain(0), 0.0f);
+    EXPECT_NEAR(profile.getForceGain(150), 1.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(profile.getForceGain(-20), 0.0f);
+    EXPECT_FLOAT_EQ(profile.getForceGain(1000), 1.5f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(0), 0.0f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(2), 0.5f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(4), 1.0f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(-1), 0.0f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(100), 1.0f);
+}
+
+TEST(AircraftProfile, FileOverridesDefaults)
+{
+    ProfileFile file("# test profile\n"
+        "force_gain 0 0.5 200 2\n"
+        "yoke_x_curve -1 -0.5 0 0 1 0.5\n"
+        "flaps_detents 0 0.2 0.7\n");
+    AircraftProfile profile;
+    profile.computeDefault(TwinParameters);
+    ASSERT_TRUE(profile.loadFromFile(file.fileName));
+    EXPECT_FLOAT_EQ(profile.getForceGain(0), 0.5f);
+    EXPECT_NEAR(profile.getForceGain(100), 1.25f, 1e-5f);
+    EXPECT_FLOAT_EQ(profile.getForceGain(300), 2.0f);
+    EXPECT_EQ(profile.getYokeXCurve(), std::vector<float>({ -1, -0.5f, 0, 0, 1, 0.5f }));
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(1), 0.2f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(5), 0.7f);     // handle indexes beyond the list keep the last position
+}
+
+TEST(AircraftProfile, OddAndShortValueLists)
+{
+    ProfileFile file("yoke_x_curve -1 -0.5 1 0.5 7\n"      // the unpaired value is ignored
+        "force_gain 0 1\n"                  // a single breakpoint is not a table
+        "flaps_detents\n");
+    AircraftProfile profile;
+    profile.computeDefault(TwinParameters);
+    ASSERT_TRUE(profile.loadFromFile(file.fileName));
+    EXPECT_EQ(profile.getYokeXCurve(), std::vector<float>({ -1, -0.5f, 1, 0.5f }));
+    EXPECT_NEAR(profile.getForceGain(150), 1.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(profile.getFlapsLeverPosition(2), 0.5f);
+}
+
+TEST(AircraftProfile, MissingFileKeepsDefaults)
+{
+    AircraftProfile profile;
+    profile.computeDefault(TwinParameters);
+    EXPECT_FALSE(profile.loadFromFile("no_such_profile.txt"));
+    EXPECT_EQ(profile.getYokeXCurve(), std::vector<float>({ -1, -1, 1, 1 }));
+}
+
+// the title is mapped to a file name in the profile directory relative to the working directory
+TEST(ProfileCache, LoadsFileOfMappedTitleOnce)
+{
+    std::filesystem::create_directories("profiles");
+    const std::string FileName = "profiles/Stand-in_Twin__Mk_2_.txt";
+    std::ofstream(FileName) << "yoke_x_curve -1 -0.25 1 0.25\n";
+    ProfileCache cache;
+    const AircraftProfile* pProfile = cache.getProfile("Stand-in Twin (Mk.2)", TwinParameters);
+    std::filesystem::remove(FileName);
+    std::filesystem::remove("profiles");    // only when empty
+    ASSERT_NE(pProfile, nullptr);
+    EXPECT_EQ(pProfile->getYokeXCurve(), std::vector<float>({ -1, -0.25f, 1, 0.25f }));
+    EXPECT_EQ(cache.getProfile("Stand-in Twin (Mk.2)", TwinParameters), pProfile);
+    EXPECT_EQ(cache.size(), 1u);
+    const AircraftProfile* pOther = cache.getProfile("Stand-in Trainer", TwinParameters);
+    EXPECT_NE(pOther, pProfile);
+    EXPECT_EQ(pOther->getYokeXCurve(), std::vector<float>({ -1, -1, 1, 1 }));
+    EXPECT_EQ(cache.size(), 2u);
+}
@@ -0,0 +1,30 @@
+#include "Arbiter.h"
+#include <gtest/gtest.h>
+
+TEST(Arbiter, RemoteChangeRequestsSet)
+{
+    Arbiter<float> arbiter;
+    EXPECT_TRUE(arbiter.setRequested(0.5f, 0.0f, 3));
+    EXPECT_FALSE(arbiter.setRequested(0.5f, 0.0f, 3));
+}
+
+TEST(Arbiter, LocalChangeBlocksRemoteForCounterLoad)
+{
+    Arbiter<float> arbiter;
+    arbiter.setRequested(0.0f, 0.0f, 3);
+    // the simulator moves its lever - the joystick is ignored for the next 2 calls
+    EXPECT_FALSE(arbiter.setRequested(0.0f, 0.3f, 3));
+    EXPECT_FALSE(arbiter.setRequested(0.1f, 0.3f, 3));
+    EXPECT_FALSE(arbiter.setRequested(0.2f, 0.3f, 3));
+    EXPECT_TRUE(arbiter.setRequested(0.3f, 0.3f, 3));
+}
+
+TEST(Arbiter, RemoteChangeHoldsOffLocalEcho)
+{
+    Arbiter<float> arbiter;
+    arbiter.setRequested(0.0f, 0.0f, 2);
+    EXPECT_TRUE(arbiter.setRequested(0.4f, 0.0f, 2));
+    // the simulator reports the value just set; it must not block the joystick
+    EXPECT_FALSE(arbiter.setRequested(0.4f, 0.4f, 2));
+    EXPECT_TRUE(arbiter.setRequested(0.5f, 0.4f, 2));
+}
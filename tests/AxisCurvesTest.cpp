@@ -0,0 +1,106 @@
+#include "AxisCurves.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+TEST(AxisCurves, DefaultCurvesAreLinear)
+{
+    AxisCurves curves;
+    float inputs[AxisCurves::NumberOfAxes] = { -0.5f, 0.25f, 0.5f, 0.75f, 1.0f };
+    float outputs[AxisCurves::NumberOfAxes];
+    curves.evaluate(inputs, outputs);
+    for (int axis = 0; axis < AxisCurves::NumberOfAxes; axis++)
+    {
+        EXPECT_NEAR(outputs[axis], inputs[axis], 1e-5f);
+    }
+}
+
+TEST(AxisCurves, DeadzoneAndDetent)
+{
+    AxisCurves curves;
+    AxisCurveConfig config;
+    config.deadzone = 0.1f;
+    curves.configure(AxisCurves::YokeX, config);
+    config = AxisCurveConfig();
+    config.detents = { 0.5f };
+    config.detentWidth = 0.05f;
+    curves.configure(AxisCurves::Throttle1, config);
+    float inputs[AxisCurves::NumberOfAxes] = { 0.05f, 0.53f, 0.53f, 0, 0 };
+    float outputs[AxisCurves::NumberOfAxes];
+    curves.evaluate(inputs, outputs);
+    EXPECT_NEAR(outputs[AxisCurves::YokeX], 0.0f, 1e-5f);
+    EXPECT_NEAR(outputs[AxisCurves::Throttle1], 0.5f, 1e-5f);
+    EXPECT_NEAR(outputs[AxisCurves::Throttle2], 0.53f, 1e-5f);
+}
+
+// a reader never sees a partly compiled table while the curves are replaced
+TEST(AxisCurves, ReconfigurationDuringEvaluation)
+{
+    AxisCurves curves;
+    AxisCurveConfig inverted;
+    inverted.points = { 0, 1, 1, 0 };
+    std::atomic<bool> stopRequest{ false };
+    std::thread writer([&]()
+        {
+            for (int count = 0; count < 200; count++)
+            {
+                curves.configure(AxisCurves::Throttle1, (count % 2) ? inverted : AxisCurveConfig());
+            }
+            stopRequest = true;
+        });
+    float inputs[AxisCurves::NumberOfAxes] = { 0, 0.25f, 0, 0, 0 };
+    float outputs[AxisCurves::NumberOfAxes];
+    while (!stopRequest)
+    {
+        curves.evaluate(inputs, outputs);
+        float output = outputs[AxisCurves::Throttle1];
+        ASSERT_TRUE((fabsf(output - 0.25f) < 1e-5f) || (fabsf(output - 0.75f) < 1e-5f)) << output;
+    }
+    writer.join();
+    EXPECT_LE(curves.getNumberOfSets(), 2u);
+}
+
+// the aircraft profile curve is the default; the curve file overrides it and a reload without the axis restores it
+TEST(AxisCurves, ProfileCurveIsDefaultAndFileOverridesIt)
+{
+    AxisCurves curves;
+    curves.setProfileCurve(AxisCurves::YokeX, { -1, -0.5f, 1, 0.5f });
+    float inputs[AxisCurves::NumberOfAxes] = { 1.0f, 0, 0, 0, 0 };
+    float outputs[AxisCurves::NumberOfAxes];
+    curves.evaluate(inputs, outputs);
+    EXPECT_NEAR(outputs[AxisCurves::YokeX], 0.5f, 1e-5f);
+
+    std::string fileName = (std::filesystem::temp_directory_path() / "mssimconnect_curves_test.txt").string();
+    std::ofstream(fileName) << "yoke_x deadzone 0.1\n";
+    ASSERT_TRUE(curves.loadFromFile(fileName));
+    curves.evaluate(inputs, outputs);
+    EXPECT_NEAR(outputs[AxisCurves::YokeX], 1.0f, 1e-5f);     // the override replaces the profile curve instead of being applied after it
+    curves.setProfileCurve(AxisCurves::YokeX, { -1, -0.25f, 1, 0.25f });
+    curves.evaluate(inputs, outputs);
+    EXPECT_NEAR(outputs[AxisCurves::YokeX], 1.0f, 1e-5f);
+
+    std::ofstream(fileName) << "throttle_1 expo 0.5\n";
+    ASSERT_TRUE(curves.loadFromFile(fileName));
+    std::filesystem::remove(fileName);
+    curves.evaluate(inputs, outputs);
+    EXPECT_NEAR(outputs[AxisCurves::YokeX], 0.25f, 1e-5f);
+}
+
+// replaced lookup tables are freed instead of accumulating over the session
+TEST(AxisCurves, ReloadsDoNotAccumulateSets)
+{
+    AxisCurves curves;
+    AxisCurveConfig config;
+    float inputs[AxisCurves::NumberOfAxes] = { 0.5f, 0.5f, 0.5f, 0.5f, 0.5f };
+    float outputs[AxisCurves::NumberOfAxes];
+    for (int count = 0; count < 100; count++)
+    {
+        config.expo = count / 100.0f;
+        curves.configure(AxisCurves::YokeX, config);
+        curves.evaluate(inputs, outputs);
+    }
+    EXPECT_EQ(curves.getNumberOfSets(), 1u);
+}
@@ -0,0 +1,139 @@
+#include "CommandSessions.h"
+#include "Console.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+namespace
+{
+    std::atomic<int> remoteCount{ 0 };
+    std::atomic<int> localCount{ 0 };
+    std::thread::id remoteThread;
+
+    void registerTestCommands(void)
+    {
+        Console::getInstance().registerCommand("testremote", "remote test command", []() { remoteCount++; remoteThread = std::this_thread::get_id(); }, true);
+        Console::getInstance().registerCommand("testlocal", "local test command", []() { localCount++; });
+        Console::getInstance().registerQuery("testquery", []() { return std::string("{\"value\":1}"); });
+    }
+}
+
+// a response is a single JSON line; trailing white space of the request is ignored
+TEST(CommandSessions, ResponsesAreSingleJsonLines)
+{
+    registerTestCommands();
+    CommandSessions sessions;
+    size_t client = sessions.connect();
+    ASSERT_NE(client, CommandSessions::NoClient);
+
+    for (auto request : { "testquery\r\n", "help", "testremote ", "unknown\n", "" })
+    {
+        ASSERT_TRUE(sessions.request(client, request)) << request;
+        std::string response = sessions.takeResponse(client);
+        ASSERT_FALSE(response.empty()) << request;
+        EXPECT_EQ(response.front(), '{') << request;
+        EXPECT_EQ(response.find('\n'), response.size() - 1) << request;
+        EXPECT_EQ(response[response.size() - 2], '}') << request;
+    }
+    EXPECT_TRUE(sessions.request(client, "testquery\r\n"));
+    EXPECT_EQ(sessions.takeResponse(client), "{\"value\":1}\n");
+    EXPECT_TRUE(sessions.takeResponse(client).empty());
+}
+
+// only the commands registered as remote are executed; help lists only them
+TEST(CommandSessions, OnlyRemoteCommandsAreExecuted)
+{
+    registerTestCommands();
+    CommandSessions sessions;
+    size_t client = sessions.connect();
+    int remoteStartCount = remoteCount;
+    int localStartCount = localCount;
+
+    sessions.request(client, "testlocal");
+    EXPECT_EQ(sessions.takeResponse(client), "{\"command\":\"testlocal\",\"result\":\"not available remotely\"}\n");
+    EXPECT_EQ(localCount, localStartCount);
+
+    sessions.request(client, "testremote");
+    EXPECT_EQ(sessions.takeResponse(client), "{\"command\":\"testremote\",\"result\":\"ok\"}\n");
+    EXPECT_EQ(remoteCount, remoteStartCount + 1);
+
+    sessions.request(client, "unknown");
+    EXPECT_EQ(sessions.takeResponse(client), "{\"result\":\"invalid command\"}\n");
+
+    sessions.request(client, "help");
+    std::string help = sessions.takeResponse(client);
+    EXPECT_NE(help.find("\"testremote\""), std::string::npos);
+    EXPECT_NE(help.find("\"testquery\""), std::string::npos);
+    EXPECT_EQ(help.find("\"testlocal\""), std::string::npos);
+}
+
+TEST(CommandSessions, AtMostFourClients)
+{
+    CommandSessions sessions;
+    std::vector<size_t> clients;
+    for (size_t index = 0; index < CommandSessions::MaxClients; index++)
+    {
+        clients.push_back(sessions.connect());
+        ASSERT_NE(clients.back(), CommandSessions::NoClient);
+    }
+    EXPECT_EQ(CommandSessions::MaxClients, 4u);
+    std::sort(clients.begin(), clients.end());
+    EXPECT_TRUE(std::adjacent_find(clients.begin(), clients.end()) == clients.end());
+    EXPECT_EQ(sessions.connect(), CommandSessions::NoClient);
+    EXPECT_EQ(sessions.getNumberOfClients(), 4u);
+
+    // a freed slot takes a new client
+    sessions.disconnect(clients[1]);
+    EXPECT_EQ(sessions.getNumberOfClients(), 3u);
+    EXPECT_EQ(sessions.connect(), clients[1]);
+    EXPECT_EQ(sessions.connect(), CommandSessions::NoClient);
+}
+
+// in reactor mode the commands of the transport thread are executed by the owner thread
+TEST(CommandSessions, DeferredCommandsRunInOwnerThread)
+{
+    registerTestCommands();
+    CommandSessions sessions;
+    sessions.setDeferredExecution(true);
+    std::vector<size_t> readyClients;
+    sessions.setResponseHandler([&readyClients](size_t client) { readyClients.push_back(client); });
+    size_t firstClient = sessions.connect();
+    size_t secondClient = sessions.connect();
+    int remoteStartCount = remoteCount;
+
+    std::thread transportThread([&]()
+        {
+            EXPECT_FALSE(sessions.request(firstClient, "testremote"));
+            EXPECT_FALSE(sessions.request(secondClient, "testquery"));
+        });
+    transportThread.join();
+    EXPECT_EQ(remoteCount, remoteStartCount);
+    EXPECT_TRUE(sessions.takeResponse(firstClient).empty());
+
+    Event* events[] = { &sessions.getRequestEvent() };
+    ASSERT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), 0u);
+    sessions.executePending();
+    EXPECT_EQ(remoteCount, remoteStartCount + 1);
+    EXPECT_EQ(remoteThread, std::this_thread::get_id());
+    EXPECT_EQ(readyClients, (std::vector<size_t>{ firstClient, secondClient }));
+    EXPECT_EQ(sessions.takeResponse(firstClient), "{\"command\":\"testremote\",\"result\":\"ok\"}\n");
+    EXPECT_EQ(sessions.takeResponse(secondClient), "{\"value\":1}\n");
+}
+
+TEST(CommandSessions, DisconnectDropsDeferredCommand)
+{
+    registerTestCommands();
+    CommandSessions sessions;
+    sessions.setDeferredExecution(true);
+    int responseCount = 0;
+    sessions.setResponseHandler([&responseCount](size_t) { responseCount++; });
+    size_t client = sessions.connect();
+    int remoteStartCount = remoteCount;
+    EXPECT_FALSE(sessions.request(client, "testremote"));
+    sessions.disconnect(client);
+    sessions.executePending();
+    EXPECT_EQ(remoteCount, remoteStartCount);
+    EXPECT_EQ(responseCount, 0);
+}
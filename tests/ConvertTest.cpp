@@ -0,0 +1,66 @@
+#include "Convert.h"
+#include "Simulator.h"
+#include <gtest/gtest.h>
+
+TEST(Convert, PlaceAndParseUnaligned)
+{
+    uint8_t buffer[16] = {};
+    uint8_t* pBuffer = buffer + 1;
+    placeData<float>(1.25f, pBuffer);
+    placeData<uint32_t>(0xDEADBEEF, pBuffer);
+    placeData<int16_t>(-2, pBuffer);
+    EXPECT_EQ(pBuffer, buffer + 11);
+    pBuffer = buffer + 1;
+    EXPECT_EQ(parseData<float>(pBuffer), 1.25f);
+    EXPECT_EQ(parseData<uint32_t>(pBuffer), 0xDEADBEEF);
+    EXPECT_EQ(parseData<int16_t>(pBuffer), -2);
+}
+
+TEST(Convert, FixedPointFractionalBits)
+{
+    EXPECT_EQ(FixedPoint16(1.0).getFractionalBits(), 14);
+    EXPECT_EQ(FixedPoint16(2.0).getFractionalBits(), 13);
+    EXPECT_EQ(FixedPoint16(4.0).getFractionalBits(), 12);
+}
+
+TEST(Convert, FixedPointSaturates)
+{
+    FixedPoint16 format(1.0);
+    EXPECT_EQ(format.encode(100.0), 32767);
+    EXPECT_EQ(format.encode(-100.0), -32768);
+    EXPECT_EQ(format.encode(0.0), 0);
+}
+
+// every raw value survives decoding and encoding, every value of the declared range is carried within a half of the resolution
+// and values beyond the range saturate
+TEST(Convert, FeedbackFormatsFullRange)
+{
+    struct
+    {
+        FixedPoint16 format;
+        double range;
+    } const feedbackFormats[] =
+    {
+        { Simulator::YokeForceFormat, 2.0 },
+        { Simulator::ThrottleLeverFormat, 1.0 },
+        { Simulator::ForceGainFormat, 4.0 },
+        { Simulator::FlapsLeverFormat, 1.0 }
+    };
+    const int Steps = 100000;
+    for (auto const& [format, range] : feedbackFormats)
+    {
+        for (int raw = -32768; raw <= 32767; raw++)
+        {
+            ASSERT_EQ(format.encode(format.decode(static_cast<int16_t>(raw))), raw) << "range " << range;
+        }
+        for (int step = -Steps; step <= Steps; step++)
+        {
+            double value = range * step / Steps;
+            ASSERT_TRUE(format.isRoundTripExact(value)) << "range " << range << ", value " << value;
+        }
+        EXPECT_EQ(format.encode(2 * range), 32767);
+        EXPECT_EQ(format.encode(-2 * range), -32768);
+    }
+    EXPECT_EQ(Simulator::YokeForceFormat.getFractionalBits(), 13);
+    EXPECT_EQ(Simulator::ThrottleLeverFormat.getFractionalBits(), 14);
+}
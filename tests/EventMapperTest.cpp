@@ -0,0 +1,49 @@
+#include "EventMapper.h"
+#include <gtest/gtest.h>
+
+TEST(EventMapper, FirstReportSetsStateOnly)
+{
+    EventMapper mapper;
+    mapper.addMapping(0, EdgeTrigger::Press, 7);
+    mapper.processInputs(0x01);
+    std::vector<uint32_t> events;
+    EXPECT_FALSE(mapper.takePendingEvents(events));
+}
+
+TEST(EventMapper, PressAndReleaseEdges)
+{
+    EventMapper mapper;
+    mapper.addMapping(0, EdgeTrigger::Press, 7);
+    mapper.addMapping(0, EdgeTrigger::Release, 8);
+    mapper.addMapping(31, EdgeTrigger::Press, 9);
+    mapper.processInputs(0);
+    mapper.processInputs(0x80000001);
+    mapper.processInputs(0x80000000);
+    std::vector<uint32_t> events;
+    ASSERT_TRUE(mapper.takePendingEvents(events));
+    EXPECT_EQ(events, (std::vector<uint32_t>{ 7, 9, 8 }));
+    EXPECT_EQ(mapper.getTriggeredCount(), 3u);
+    EXPECT_FALSE(mapper.takePendingEvents(events));
+}
+
+TEST(EventMapper, UnmappedInputsAreIgnored)
+{
+    EventMapper mapper;
+    mapper.addMapping(40, EdgeTrigger::Press, 1);
+    mapper.processInputs(0);
+    mapper.processInputs(0xFFFFFFFF);
+    std::vector<uint32_t> events;
+    EXPECT_FALSE(mapper.takePendingEvents(events));
+}
+
+TEST(EventMapper, SetMappingsReplacesTable)
+{
+    EventMapper mapper;
+    mapper.addMapping(0, EdgeTrigger::Press, 7);
+    mapper.setMappings({ { 1, EdgeTrigger::Press, 3 } });
+    mapper.processInputs(0);
+    mapper.processInputs(0x03);
+    std::vector<uint32_t> events;
+    ASSERT_TRUE(mapper.takePendingEvents(events));
+    EXPECT_EQ(events, (std::vector<uint32_t>{ 3 }));
+}
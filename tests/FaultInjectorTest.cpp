@@ -0,0 +1,100 @@
+#include "FaultInjector.h"
+#include <gtest/gtest.h>
+#include <iostream>
+
+TEST(FaultInjector, ResultsKeepConsoleNumberFormat)
+{
+    auto flags = std::cout.flags();
+    auto precision = std::cout.precision();
+    FaultInjector::getInstance().displayResults();
+    EXPECT_EQ(std::cout.flags(), flags);
+    EXPECT_EQ(std::cout.precision(), precision);
+}
+
+#ifdef FAULT_INJECTION
+#include "Simulator.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// all fault scenarios against the stand-in server and joystick, each serviced by its own thread
+TEST(FaultInjector, ScenariosRecoverWithStandIns)
+{
+    SimConnectStandIn& server = SimConnectStandIn::getInstance();
+    server.reset();
+    initializeStandInFlight(server);
+    StandInJoystick joystick(StandInJoystick::Format::Vendor);
+    Simulator::getInstance().setJoystickLink(&joystick);
+    joystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+    std::atomic<bool> stopRequest{ false };
+    std::thread serverThread([&]()
+        {
+            while (!stopRequest)
+            {
+                server.runFrame();
+                std::this_thread::sleep_for(std::chrono::microseconds(1000000 / SimConnectStandIn::FramesPerSecond));
+            }
+        });
+    std::thread joystickThread([&]()
+        {
+            while (!stopRequest)
+            {
+                if (joystick.isConnectionOpen())
+                {
+                    joystick.sendReport();
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(4));
+            }
+        });
+    std::thread simulatorThread([&]()
+        {
+            while (!stopRequest)
+            {
+                Simulator::getInstance().service();
+                Simulator::getInstance().waitForService();
+            }
+        });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!server.isConnected() && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(server.isConnected());
+
+    // the counts of the injector accumulate over runs
+    FaultInjector& injector = FaultInjector::getInstance();
+    uint32_t recoveryCounts[FaultInjector::NumberOfFaults];
+    uint32_t detectionCounts[FaultInjector::NumberOfFaults];
+    for (int fault = 0; fault < FaultInjector::NumberOfFaults; fault++)
+    {
+        recoveryCounts[fault] = injector.getRecoveryCount(static_cast<FaultInjector::Fault>(fault));
+        detectionCounts[fault] = injector.getDetectionCount(static_cast<FaultInjector::Fault>(fault));
+    }
+    injector.runScenarios();
+    stopRequest = true;
+    Simulator::getInstance().getWakeupEvent().set();
+    simulatorThread.join();
+    joystickThread.join();
+    serverThread.join();
+    Simulator::getInstance().shutdown();
+    Simulator::getInstance().setJoystickLink(nullptr);
+
+    for (int fault = 0; fault < FaultInjector::NumberOfFaults; fault++)
+    {
+        EXPECT_EQ(injector.getRecoveryCount(static_cast<FaultInjector::Fault>(fault)) - recoveryCounts[fault], 1u) << "fault " << fault;
+        // the first valid data after the fault end; a reconnection waits for the retry period
+        EXPECT_LT(injector.getRecoverTimeMax(static_cast<FaultInjector::Fault>(fault)), 1000.0) << "fault " << fault;
+    }
+    // faults which the client can notice with the default deadlines; a dropped or delayed report and a failed feedback write are not visible
+    for (auto fault : { FaultInjector::UsbShortReport, FaultInjector::UsbDisconnect, FaultInjector::SimDropMessage, FaultInjector::SimGarbageID,
+        FaultInjector::SimDisconnect, FaultInjector::SimStall })
+    {
+        EXPECT_EQ(injector.getDetectionCount(fault) - detectionCounts[fault], 1u) << "fault " << fault;
+        EXPECT_LT(injector.getDetectTimeMax(fault), 500.0) << "fault " << fault;     // the simulator data deadline is 200 ms
+    }
+}
+#endif
@@ -0,0 +1,20 @@
+#include "PiecewiseLinear.h"
+#include <gtest/gtest.h>
+
+TEST(PiecewiseLinear, SegmentsAndClamping)
+{
+    std::vector<float> breakpoints = { 0, 0, 100, 1, 200, 1.5f };
+    EXPECT_FLOAT_EQ(piecewiseLinear(breakpoints, 50), 0.5f);
+    EXPECT_FLOAT_EQ(piecewiseLinear(breakpoints, 100), 1.0f);
+    EXPECT_FLOAT_EQ(piecewiseLinear(breakpoints, 150), 1.25f);
+    EXPECT_FLOAT_EQ(piecewiseLinear(breakpoints, -10), 0.0f);
+    EXPECT_FLOAT_EQ(piecewiseLinear(breakpoints, 500), 1.5f);
+}
+
+TEST(PiecewiseLinear, ShortAndOddLists)
+{
+    EXPECT_FLOAT_EQ(piecewiseLinear({}, 0.3f), 0.3f);
+    EXPECT_FLOAT_EQ(piecewiseLinear({ 0, 1 }, 0.3f), 0.3f);
+    EXPECT_FLOAT_EQ(piecewiseLinear({ -1, -0.5f, 1, 0.5f, 7 }, 1), 0.5f);
+    EXPECT_FLOAT_EQ(piecewiseLinear({ 0, 0, 0, 1 }, 0.5f), 0.0f);     // zero width segment
+}
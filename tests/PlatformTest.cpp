@@ -0,0 +1,116 @@
+#include "Platform.h"
+#include <gtest/gtest.h>
+#include <thread>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+TEST(Platform, AutomaticResetEventIsConsumedByWait)
+{
+    Event event(false);
+    Event* events[] = { &event };
+    event.set();
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), 0u);
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), Event::Timeout);
+}
+
+TEST(Platform, ManualResetEventStaysSignaled)
+{
+    Event event(true);
+    Event* events[] = { &event };
+    event.set();
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), 0u);
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), 0u);
+    event.reset();
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(0)), Event::Timeout);
+}
+
+TEST(Platform, WaitReturnsIndexOfSignaledEvent)
+{
+    Event first(false);
+    Event second(false);
+    Event* events[] = { &first, &second };
+    std::thread signaler([&second]() { Event::signal(second.getNativeHandle()); });
+    EXPECT_EQ(Event::waitAny(events, 2, std::chrono::milliseconds(1000)), 1u);
+    signaler.join();
+}
+
+TEST(Platform, ShortWaitLastsWholeTimeout)
+{
+    Event event(false);
+    Event* events[] = { &event };
+    auto startTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(Event::waitAny(events, 1, std::chrono::milliseconds(1)), Event::Timeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(1));
+}
+
+TEST(Platform, ProcessCounters)
+{
+    EXPECT_NE(getThreadId(), 0u);
+    EXPECT_GT(getPrivateMemorySize(), 0u);
+    EXPECT_GT(getHandleCount(), 0u);
+}
+
+#ifndef _WIN32
+// standard input is replaced by a pipe for the console input tests
+class ConsoleInput : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(pipe(inputPipe), 0);
+        savedInput = dup(STDIN_FILENO);
+        dup2(inputPipe[0], STDIN_FILENO);
+        close(inputPipe[0]);
+    }
+    void TearDown() override
+    {
+        closeInput();
+        dup2(savedInput, STDIN_FILENO);
+        close(savedInput);
+    }
+    void write(std::string text)
+    {
+        ASSERT_EQ(::write(inputPipe[1], text.data(), text.size()), static_cast<ssize_t>(text.size()));
+    }
+    void closeInput(void)
+    {
+        if (inputPipe[1] >= 0)
+        {
+            close(inputPipe[1]);
+            inputPipe[1] = -1;
+        }
+    }
+    int inputPipe[2]{ -1, -1 };
+    int savedInput{ -1 };
+    Event quitEvent{ true };
+};
+
+TEST_F(ConsoleInput, LinesAreSplitAndLastLineIsReturnedAtEnd)
+{
+    std::string line;
+    write("help\nsimdata\nqu");
+    write("it");
+    closeInput();
+    ASSERT_TRUE(readConsoleLine(line, quitEvent));
+    EXPECT_EQ(line, "help");
+    ASSERT_TRUE(readConsoleLine(line, quitEvent));
+    EXPECT_EQ(line, "simdata");
+    ASSERT_TRUE(readConsoleLine(line, quitEvent));
+    EXPECT_EQ(line, "quit");
+    EXPECT_FALSE(readConsoleLine(line, quitEvent));
+}
+
+TEST_F(ConsoleInput, QuitWakesUpBlockedRead)
+{
+    std::string line;
+    std::thread quitter([this]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            quitEvent.set();
+            cancelConsoleInput();
+        });
+    EXPECT_FALSE(readConsoleLine(line, quitEvent));
+    quitter.join();
+}
+#endif
@@ -0,0 +1,89 @@
+#include "ReportDescriptor.h"
+#include "ReportFixtures.h"
+#include <gtest/gtest.h>
+
+// the descriptor of every fixture device fed through the layout discovery gives the layout of the fixture
+TEST(ReportDescriptor, DeviceDescriptorsGiveFixtureLayouts)
+{
+    for (auto const& fixture : getReportFixtures())
+    {
+        ReportDescriptor descriptor;
+        ASSERT_TRUE(descriptor.parse(fixture.descriptor)) << fixture.name;
+        uint8_t reportID = fixture.report[0];
+        EXPECT_EQ(descriptor.getInputReportSize(reportID), fixture.report.size()) << fixture.name;
+
+        ReportLayout layout;
+        descriptor.buildReportLayout(layout, reportID);
+        ASSERT_EQ(layout.getNumberOfValueFields(), fixture.valueFields.size()) << fixture.name;
+        for (size_t index = 0; index < fixture.valueFields.size(); index++)
+        {
+            const ReportField& field = layout.getValueField(index);
+            const ReportField& expected = fixture.valueFields[index];
+            EXPECT_EQ(field.usagePage, expected.usagePage) << fixture.name << ", field " << index;
+            EXPECT_EQ(field.usage, expected.usage) << fixture.name << ", field " << index;
+            EXPECT_EQ(field.bitOffset, expected.bitOffset) << fixture.name << ", field " << index;
+            EXPECT_EQ(field.bitSize, expected.bitSize) << fixture.name << ", field " << index;
+            EXPECT_EQ(field.logicalMin, expected.logicalMin) << fixture.name << ", field " << index;
+            EXPECT_EQ(field.logicalMax, expected.logicalMax) << fixture.name << ", field " << index;
+            EXPECT_EQ(ReportLayout::extract(fixture.report.data(), fixture.report.size(), field.bitOffset, field.bitSize, field.logicalMin < 0), fixture.values[index])
+                << fixture.name << ", field " << index;
+        }
+        EXPECT_EQ(layout.getButtons(fixture.report.data(), fixture.report.size()), fixture.buttons) << fixture.name;
+        EXPECT_EQ(layout.getButtonsEnd(), static_cast<size_t>((fixture.firstButtonBit + fixture.numberOfButtons + 7) / 8)) << fixture.name;
+    }
+}
+
+TEST(ReportDescriptor, OtherReportsAreNotInTheLayout)
+{
+    const ReportFixture& fixture = getReportFixtures().front();
+    ReportDescriptor descriptor;
+    ASSERT_TRUE(descriptor.parse(fixture.descriptor));
+    ReportLayout layout;
+    descriptor.buildReportLayout(layout, 1);
+    EXPECT_EQ(layout.getNumberOfValueFields(), 0u);
+    EXPECT_EQ(descriptor.getInputReportSize(1), 0u);
+}
+
+// padding, array buttons, push/pop and extended usages
+TEST(ReportDescriptor, PaddingArraysAndGlobalStack)
+{
+    const std::vector<uint8_t> bytes
+    {
+        0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,
+        0x75, 0x03, 0x95, 0x01, 0x81, 0x03,     // 3 bits of padding
+        0xA4,                                   // push
+        0x0B, 0x32, 0x00, 0x01, 0x00, 0x15, 0x00, 0x25, 0x1F, 0x75, 0x05, 0x95, 0x01, 0x81, 0x02,     // generic desktop Z as extended usage, 5 bits
+        0xB4,                                   // pop - the report size is 3 again
+        0x05, 0x09, 0x19, 0x01, 0x29, 0x05, 0x15, 0x01, 0x25, 0x05, 0x75, 0x03, 0x95, 0x02, 0x81, 0x00,     // two array slots of buttons 1..5
+        0xC0
+    };
+    ReportDescriptor descriptor;
+    ASSERT_TRUE(descriptor.parse(bytes));
+    EXPECT_EQ(descriptor.getInputReportSize(0), 3u);    // unused byte 0 + 14 bits
+    ReportLayout layout;
+    descriptor.buildReportLayout(layout, 0);
+    int zField = layout.findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageZ);
+    ASSERT_GE(zField, 0);
+    EXPECT_EQ(layout.getValueField(zField).bitOffset, 11);
+    EXPECT_EQ(layout.getValueField(zField).bitSize, 5);
+
+    // an array slot carries the button number; the first free slot takes it
+    std::vector<uint8_t> report(3, 0);
+    EXPECT_TRUE(descriptor.setUsage(report, ReportLayout::ButtonPage, 0, 4, 1, true));
+    EXPECT_TRUE(descriptor.setUsage(report, ReportLayout::ButtonPage, 0, 2, 1, true));
+    EXPECT_EQ(ReportLayout::extract(report.data(), report.size(), 16, 3, false), 4);
+    EXPECT_EQ(ReportLayout::extract(report.data(), report.size(), 19, 3, false), 2);
+    EXPECT_FALSE(descriptor.setUsage(report, ReportLayout::ButtonPage, 0, 6, 1, true));
+}
+
+TEST(ReportDescriptor, MalformedDescriptorsAreRejected)
+{
+    ReportDescriptor descriptor;
+    EXPECT_FALSE(descriptor.parse({ 0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0x26, 0xFF }));     // truncated item
+    EXPECT_FALSE(descriptor.parse({ 0x05, 0x01, 0x09, 0x04, 0xA1, 0x01 }));     // open collection
+    EXPECT_FALSE(descriptor.parse({ 0xC0 }));       // end without collection
+    EXPECT_FALSE(descriptor.parse({ 0xB4 }));       // pop without push
+    EXPECT_FALSE(descriptor.parse({ 0x85, 0x00 }));     // report ID 0 is reserved
+    EXPECT_FALSE(descriptor.parse({ 0x75, 0x20, 0x96, 0xFF, 0xFF, 0x81, 0x02 }));   // report beyond the 16-bit bit offsets
+    EXPECT_TRUE(descriptor.parse({}));
+}
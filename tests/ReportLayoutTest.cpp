@@ -0,0 +1,69 @@
+#include "ReportLayout.h"
+#include "ReportFixtures.h"
+#include <gtest/gtest.h>
+
+TEST(ReportLayout, ExtractSignedAndUnsigned)
+{
+    const uint8_t report[] = { 0x02, 0xFF, 0x7F, 0x01, 0x80, 0xF0 };
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 8, 16, true), 32767);
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 24, 16, true), -32767);
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 44, 4, false), 0xF);
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 44, 4, true), -1);
+}
+
+TEST(ReportLayout, ExtractBeyondReportEndReadsZero)
+{
+    const uint8_t report[] = { 0x02, 0xFF };
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 12, 16, false), 0xF);
+    EXPECT_EQ(ReportLayout::extract(report, sizeof(report), 32, 8, false), 0);
+}
+
+TEST(ReportLayout, ScaledValuesAndButtons)
+{
+    ReportLayout layout;
+    layout.addValueField({ ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 16, -32767, 32767 });
+    layout.addValueField({ ReportLayout::SimulationPage, ReportLayout::UsageThrottle, 24, 8, 0, 255 });
+    layout.addButton(1, 32);
+    layout.addButton(3, 34);
+    int xField = layout.findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageX);
+    int throttleField = layout.findValueField(ReportLayout::SimulationPage, ReportLayout::UsageThrottle);
+    ASSERT_GE(xField, 0);
+    ASSERT_GE(throttleField, 0);
+    EXPECT_TRUE(layout.findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageY) == ReportLayout::NoField);
+
+    const uint8_t report[] = { 0x02, 0x01, 0x80, 0xFF, 0x05 };
+    EXPECT_FLOAT_EQ(layout.getBipolar(report, sizeof(report), xField), -1.0f);
+    EXPECT_FLOAT_EQ(layout.getUnipolar(report, sizeof(report), throttleField), 1.0f);
+    EXPECT_EQ(layout.getButtons(report, sizeof(report)), 0x05u);
+}
+
+TEST(ReportLayout, DeviceFixtures)
+{
+    for (auto const& fixture : getReportFixtures())
+    {
+        ReportLayout layout = fixture.makeLayout();
+        ASSERT_EQ(layout.getNumberOfValueFields(), fixture.values.size()) << fixture.name;
+        for (size_t index = 0; index < fixture.values.size(); index++)
+        {
+            const ReportField& field = layout.getValueField(index);
+            EXPECT_EQ(ReportLayout::extract(fixture.report.data(), fixture.report.size(), field.bitOffset, field.bitSize, field.logicalMin < 0), fixture.values[index])
+                << fixture.name << ", field " << index;
+        }
+        EXPECT_EQ(layout.getButtons(fixture.report.data(), fixture.report.size()), fixture.buttons) << fixture.name;
+        EXPECT_GE(layout.findValueField(ReportLayout::GenericDesktopPage, ReportLayout::UsageX), 0) << fixture.name;
+    }
+}
+
+TEST(ReportLayout, FieldAndButtonEnds)
+{
+    ReportLayout layout;
+    layout.addValueField({ ReportLayout::GenericDesktopPage, ReportLayout::UsageX, 8, 16, -32767, 32767 });
+    layout.addValueField({ ReportLayout::SimulationPage, ReportLayout::UsageThrottle, 28, 8, 0, 255 });
+    EXPECT_EQ(layout.getFieldEnd(0), 3u);
+    EXPECT_EQ(layout.getFieldEnd(1), 5u);
+    EXPECT_EQ(layout.getFieldEnd(ReportLayout::NoField), 0u);
+    EXPECT_EQ(layout.getButtonsEnd(), 0u);
+    layout.addButton(1, 40);
+    layout.addButton(2, 47);
+    EXPECT_EQ(layout.getButtonsEnd(), 6u);
+}
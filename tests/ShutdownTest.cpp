@@ -0,0 +1,54 @@
+#include "Console.h"
+#include "Simulator.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include <gtest/gtest.h>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <cstdlib>
+
+namespace
+{
+    // runs the handlers like the headless client, requests quit and exits with 0 when all threads stopped within the limit
+    void runAndQuit(std::chrono::milliseconds limit)
+    {
+        SimConnectStandIn& server = SimConnectStandIn::getInstance();
+        server.reset();
+        initializeStandInFlight(server);
+        StandInJoystick joystick(StandInJoystick::Format::Vendor);
+        Simulator::getInstance().setJoystickLink(&joystick);
+        joystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+        std::thread serverThread([&]()
+            {
+                while (!Console::getInstance().isQuitRequest())
+                {
+                    server.runFrame();
+                    std::this_thread::sleep_for(std::chrono::microseconds(1000000 / SimConnectStandIn::FramesPerSecond));
+                }
+            });
+        std::thread joystickThread(&StandInJoystick::handler, &joystick);
+        std::thread simulatorThread(&Simulator::handler, &Simulator::getInstance());
+        // connected and idle: the simulator thread waits for SimConnect messages, the joystick thread for its report period
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        bool isConnected = server.isConnected();
+
+        auto quitTime = std::chrono::steady_clock::now();
+        Console::getInstance().quit();
+        simulatorThread.join();
+        joystickThread.join();
+        auto stopTime = std::chrono::steady_clock::now() - quitTime;
+        serverThread.join();
+        std::cerr << "threads stopped in " << std::chrono::duration<double, std::milli>(stopTime).count() << " ms" << std::endl;
+        std::exit(isConnected && (stopTime < limit) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+}
+
+// the quit request is irreversible, so the run takes place in a child process
+TEST(ShutdownDeathTest, QuitStopsHandlersWithin50ms)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(runAndQuit(std::chrono::milliseconds(50)), ::testing::ExitedWithCode(EXIT_SUCCESS), "threads stopped in");
+}
@@ -0,0 +1,220 @@
+#include "Simulator.h"
+#include "SimConnectStandIn.h"
+#include "StandInJoystick.h"
+#include "StandInFlight.h"
+#include <gtest/gtest.h>
+#include <functional>
+#include <thread>
+#include <string>
+
+// the simulator logic against the stand-in server and joystick; the handler is serviced by the test itself
+class SimulatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        server.reset();
+        initializeStandInFlight(server);
+        Simulator::getInstance().setJoystickLink(&joystick);
+        joystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+    }
+    void TearDown() override
+    {
+        Simulator::getInstance().shutdown();
+        Simulator::getInstance().setJoystickLink(nullptr);
+        Simulator::getInstance().setTrafficEnabled(false);
+        Simulator::getInstance().setEventDrivenDispatch(true);
+        Simulator::getInstance().setWriteCoalescing(true);
+        server.setNumberOfTrafficObjects(0);
+    }
+    // service the client until it is connected and has processed the first simulator frame
+    bool connect(void)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!server.isConnected() && (std::chrono::steady_clock::now() < deadline))
+        {
+            Simulator::getInstance().service();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        runFrame();
+        return server.isConnected();
+    }
+    void runFrame(void)
+    {
+        server.runFrame();
+        Simulator::getInstance().service();
+    }
+    SimConnectStandIn& server{ SimConnectStandIn::getInstance() };
+    StandInJoystick joystick{ StandInJoystick::Format::Vendor };
+    static const SIMCONNECT_DATA_DEFINITION_ID WriteDefinition = 2;    // SimDataWriteDefinition of the client
+};
+
+TEST(Simulator, FeedbackFrameLayout)
+{
+    uint8_t frame[64] = {};
+    Simulator::FeedbackData data{ 3, 1, -0.5, 0x05, 0.75, 1.5f, 0.5f };
+    ASSERT_EQ(Simulator::packFeedback(data, frame), 18u);
+    uint8_t* pData = frame;
+    EXPECT_EQ(parseData<uint8_t>(pData), 3);
+    EXPECT_EQ(parseData<uint8_t>(pData), 1);
+    EXPECT_EQ(parseFixed<double>(Simulator::YokeForceFormat, pData), -0.5);
+    EXPECT_EQ(parseData<uint32_t>(pData), 0x05u);
+    EXPECT_EQ(parseFixed<double>(Simulator::ThrottleLeverFormat, pData), 0.75);
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(pData), 3), "SIM");
+    pData += 3;
+    EXPECT_EQ(parseData<uint8_t>(pData), Simulator::FeedbackFormatVersion);
+    EXPECT_EQ(parseFixed<float>(Simulator::ForceGainFormat, pData), 1.5f);
+    EXPECT_EQ(parseFixed<float>(Simulator::FlapsLeverFormat, pData), 0.5f);
+}
+
+TEST_F(SimulatorTest, FeedbackCarriesYokeForce)
+{
+    ASSERT_TRUE(connect());
+    server.setSimVar("AILERON POSITION", 0.3);
+    server.setSimVar("YOKE X INDICATOR", 0.1);
+    runFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    runFrame();
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(joystick.getLastFeedback(frame));
+    uint8_t* pData = &frame[2];
+    EXPECT_NEAR(parseFixed<double>(Simulator::YokeForceFormat, pData), 0.2, Simulator::YokeForceFormat.getResolution());
+    EXPECT_EQ(parseData<uint32_t>(pData) & 1, 1u);     // simulator data valid
+}
+
+TEST_F(SimulatorTest, JoystickInputIsWrittenToSimulator)
+{
+    ASSERT_TRUE(connect());
+    uint32_t setDataCount = server.getSetDataCount(WriteDefinition);
+    joystick.setInputs(0.5f, 0.2f, 0);
+    joystick.sendReport();
+    runFrame();
+    EXPECT_GT(server.getSetDataCount(WriteDefinition), setDataCount);
+}
+
+TEST_F(SimulatorTest, ReconnectsAfterServerQuit)
+{
+    ASSERT_TRUE(connect());
+    server.quit();
+    Simulator::getInstance().service();
+    EXPECT_FALSE(server.isConnected());
+    EXPECT_TRUE(connect());
+}
+
+TEST_F(SimulatorTest, TruncatedVendorReportIsRejected)
+{
+    ASSERT_TRUE(connect());
+    uint32_t setDataCount = server.getSetDataCount(WriteDefinition);
+    std::vector<uint8_t> report(1 + sizeof(float), 0);
+    report[0] = StandInJoystick::ReportID;
+    report[3] = 0x3F;     // yoke X = 0.5 in the bytes which are present
+    Simulator::getInstance().parseReceivedData(report);
+    runFrame();
+    EXPECT_EQ(server.getSetDataCount(WriteDefinition), setDataCount);
+}
+
+TEST_F(SimulatorTest, ShortStandardReportIsAccepted)
+{
+    StandInJoystick standardJoystick(StandInJoystick::Format::Standard);
+    Simulator::getInstance().setJoystickLink(&standardJoystick);
+    standardJoystick.setParseFunction(std::bind(&Simulator::parseReceivedData, &Simulator::getInstance(), std::placeholders::_1));
+    ASSERT_TRUE(connect());
+    uint32_t setDataCount = server.getSetDataCount(WriteDefinition);
+    standardJoystick.setInputs(0.5f, 0.2f, 0);
+    standardJoystick.sendReport();
+    runFrame();
+    EXPECT_GT(server.getSetDataCount(WriteDefinition), setDataCount);
+}
+
+TEST_F(SimulatorTest, TruncatedStandardReportIsRejected)
+{
+    StandInJoystick standardJoystick(StandInJoystick::Format::Standard);
+    Simulator::getInstance().setJoystickLink(&standardJoystick);
+    ASSERT_TRUE(connect());
+    uint32_t setDataCount = server.getSetDataCount(WriteDefinition);
+    std::vector<uint8_t> report = { StandInJoystick::ReportID, 0xFF, 0x3F };     // yoke X present, throttle and buttons missing
+    Simulator::getInstance().parseReceivedData(report);
+    runFrame();
+    EXPECT_EQ(server.getSetDataCount(WriteDefinition), setDataCount);
+    report.push_back(0x80);
+    report.push_back(0x00);
+    Simulator::getInstance().parseReceivedData(report);
+    runFrame();
+    EXPECT_GT(server.getSetDataCount(WriteDefinition), setDataCount);
+}
+
+TEST_F(SimulatorTest, SteadyStickKeepsYokeAndUnplugCentersIt)
+{
+    ASSERT_TRUE(connect());
+    joystick.setInputs(0.5f, 0.2f, 0);
+    joystick.sendReport();
+    runFrame();
+    // no reports from a steady stick - the yoke position stays
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    runFrame();
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(server.getLastSetData(WriteDefinition, data));
+    double yokeXposition = reinterpret_cast<const double*>(data.data())[1];
+    EXPECT_NE(yokeXposition, 0.0);
+    joystick.setConnected(false);
+    runFrame();
+    runFrame();
+    ASSERT_TRUE(server.getLastSetData(WriteDefinition, data));
+    yokeXposition = reinterpret_cast<const double*>(data.data())[1];
+    EXPECT_EQ(yokeXposition, 0.0);
+    joystick.setConnected(true);
+}
+
+TEST_F(SimulatorTest, VendorButtonsNeedReportVersion)
+{
+    ASSERT_TRUE(connect());
+    uint32_t transmitCount = server.getTransmitCount("GEAR_TOGGLE");
+    std::vector<uint8_t> report(StandInJoystick::ReportSize, 0);
+    report[0] = StandInJoystick::ReportID;
+    Simulator::getInstance().parseReceivedData(report);
+    report[VendorReport::ButtonsOffset] = 0x01;     // button 0 without the report version
+    Simulator::getInstance().parseReceivedData(report);
+    runFrame();
+    EXPECT_EQ(server.getTransmitCount("GEAR_TOGGLE"), transmitCount);
+    report[VendorReport::VersionOffset] = VendorReport::ButtonsVersion;
+    report[VendorReport::ButtonsOffset] = 0x00;
+    Simulator::getInstance().parseReceivedData(report);
+    report[VendorReport::ButtonsOffset] = 0x01;
+    Simulator::getInstance().parseReceivedData(report);
+    runFrame();
+    EXPECT_EQ(server.getTransmitCount("GEAR_TOGGLE"), transmitCount + 1);
+}
+
+TEST_F(SimulatorTest, TrafficSweepsAreOptIn)
+{
+    server.setNumberOfTrafficObjects(3);
+    ASSERT_TRUE(connect());
+    uint32_t sweepCount = Simulator::getInstance().getTrafficTable().getSweepCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    runFrame();
+    runFrame();
+    EXPECT_EQ(Simulator::getInstance().getTrafficTable().getSweepCount(), sweepCount);
+    EXPECT_EQ(Simulator::getInstance().getTrafficTable().size(), 0u);
+}
+
+TEST_F(SimulatorTest, LostTrafficReplyStartsNewSweep)
+{
+    Simulator::getInstance().setTrafficEnabled(true);
+    server.setNumberOfTrafficObjects(3);
+    server.setLastTrafficReplyLost(true);
+    ASSERT_TRUE(connect());
+    uint32_t sweepCount = Simulator::getInstance().getTrafficTable().getSweepCount();
+    for (int frame = 0; frame < 3; frame++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        runFrame();
+    }
+    // the sweep waits for its last reply
+    EXPECT_EQ(Simulator::getInstance().getTrafficTable().getSweepCount(), sweepCount);
+    server.setLastTrafficReplyLost(false);
+    SessionClock::advance(std::chrono::milliseconds(1100));
+    runFrame();
+    runFrame();
+    EXPECT_GT(Simulator::getInstance().getTrafficTable().getSweepCount(), sweepCount);
+    EXPECT_EQ(Simulator::getInstance().getTrafficTable().size(), 3u);
+}
@@ -0,0 +1,34 @@
+#include "TrafficTable.h"
+#include <gtest/gtest.h>
+
+TEST(TrafficTable, UpdateAndFind)
+{
+    TrafficTable table;
+    table.update({ 5, 50.0, 14.0, 3000, 90, 120, 0 });
+    table.update({ 5, 50.1, 14.0, 3100, 90, 120, 500 });
+    EXPECT_EQ(table.size(), 1u);
+    TrafficObject object;
+    ASSERT_TRUE(table.find(5, object));
+    EXPECT_EQ(object.latitude, 50.1);
+    EXPECT_EQ(object.verticalSpeed, 500);
+    EXPECT_FALSE(table.find(6, object));
+}
+
+TEST(TrafficTable, SweepRemovesObjectsNotReported)
+{
+    TrafficTable table;
+    for (uint32_t id = 1; id <= 4; id++)
+    {
+        table.update({ id, 0, 0, 0, 0, 0, 0 });
+    }
+    table.endSweep();
+    table.update({ 2, 0, 0, 0, 0, 0, 0 });
+    table.update({ 4, 0, 0, 0, 0, 0, 0 });
+    table.endSweep();
+    EXPECT_EQ(table.size(), 2u);
+    TrafficObject object;
+    EXPECT_TRUE(table.find(2, object));
+    EXPECT_TRUE(table.find(4, object));
+    EXPECT_FALSE(table.find(1, object));
+    EXPECT_EQ(table.getSweepCount(), 2u);
+}
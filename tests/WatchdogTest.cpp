@@ -0,0 +1,36 @@
+#include "Watchdog.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(Watchdog, StreamsStartExpired)
+{
+    Watchdog watchdog;
+    EXPECT_TRUE(watchdog.isExpired(Watchdog::SimData));
+    EXPECT_EQ(watchdog.check(), 0u);
+}
+
+TEST(Watchdog, FeedRestoresAndDeadlineExpires)
+{
+    Watchdog watchdog;
+    watchdog.setDeadline(Watchdog::SimData, std::chrono::milliseconds(20));
+    watchdog.feed(Watchdog::SimData);
+    EXPECT_EQ(watchdog.check(), 1u << Watchdog::SimData);
+    EXPECT_FALSE(watchdog.isExpired(Watchdog::SimData));
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(watchdog.check(), 1u << Watchdog::SimData);
+    EXPECT_TRUE(watchdog.isExpired(Watchdog::SimData));
+}
+
+TEST(Watchdog, ZeroDeadlineExpiresOnlyOnLinkLoss)
+{
+    Watchdog watchdog;
+    watchdog.setDeadline(Watchdog::JoystickData, std::chrono::milliseconds(0));
+    watchdog.feed(Watchdog::JoystickData);
+    EXPECT_EQ(watchdog.check(), 1u << Watchdog::JoystickData);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(watchdog.check(), 0u);
+    EXPECT_FALSE(watchdog.isExpired(Watchdog::JoystickData));
+    watchdog.expire(Watchdog::JoystickData);
+    EXPECT_EQ(watchdog.check(), 1u << Watchdog::JoystickData);
+    EXPECT_TRUE(watchdog.isExpired(Watchdog::JoystickData));
+}
@@ -0,0 +1,49 @@
+#include "WriteCoalescer.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    struct TwoFields
+    {
+        double first;
+        double second;
+    };
+}
+
+TEST(WriteCoalescer, UpdatesMergeIntoOneWrite)
+{
+    WriteCoalescer<TwoFields> coalescer(0.001);
+    coalescer.update({ 1, 2 });
+    coalescer.update({ 3, 4 });
+    TwoFields data;
+    ASSERT_TRUE(coalescer.getDataToFlush(data));
+    EXPECT_EQ(data.first, 3);
+    EXPECT_EQ(data.second, 4);
+    EXPECT_FALSE(coalescer.getDataToFlush(data));
+    EXPECT_EQ(coalescer.getWriteCount(), 1u);
+    EXPECT_EQ(coalescer.getMergedCount(), 1u);
+}
+
+TEST(WriteCoalescer, ChangesWithinDeadbandAreSkipped)
+{
+    WriteCoalescer<TwoFields> coalescer(0.01);
+    TwoFields data;
+    coalescer.update({ 1, 1 });
+    coalescer.getDataToFlush(data);
+    coalescer.update({ 1.005, 1 });
+    EXPECT_FALSE(coalescer.getDataToFlush(data));
+    EXPECT_EQ(coalescer.getUnchangedCount(), 1u);
+    coalescer.update({ 1.005, 1 }, true);
+    EXPECT_TRUE(coalescer.getDataToFlush(data));
+}
+
+TEST(WriteCoalescer, InvalidateForcesNextWrite)
+{
+    WriteCoalescer<TwoFields> coalescer(0.01);
+    TwoFields data;
+    coalescer.update({ 1, 1 });
+    coalescer.getDataToFlush(data);
+    coalescer.invalidate();
+    coalescer.update({ 1, 1 });
+    EXPECT_TRUE(coalescer.getDataToFlush(data));
+}